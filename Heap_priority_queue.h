@@ -3,171 +3,294 @@
 
 #include <stdexcept>
 #include <iostream>
-
-template <typename T>
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include "priority_order.h"
+#include "heap_sift.h"
+#include "shared_buffer.h"
+#include "parallel_tasks.h"
+
+//Priority - typ priorytetu, Compare - porzadek jak w std::priority_queue (domyslnie najwiekszy pierwszy)
+//Stability - StableOrder (FIFO przy rownych priorytetach) albo UnstableOrder (bez czasu wstawienia)
+//kopie kolejki wspoldziela tablice (copy-on-write) az do pierwszej modyfikacji, migawki sa kopiowane
+//leniwie stronami
+template <typename T, typename Priority = int, typename Compare = std::less<Priority>, typename Stability = StableOrder>
 class HeapPriorityQueue {
 private:
- //struktura  do przechowywania  elementu  jego priorytetu i czas wstawienia
-    struct HeapElement {
-        int priority;
-        T value;
-        unsigned long insertTime;  
+    typedef PriorityOrder<Priority, Compare> Order;
+
+ //struktura  do przechowywania  elementu  jego priorytetu i czas wstawienia (tylko w trybie stabilnym)
+    typedef PriorityEntry<T, Priority, Stability> HeapElement;
+
+    SharedBuffer<HeapElement> storage;  //tablica kopca wspoldzielona z kopiami (migawki kopiowane leniwie stronami)
+    HeapElement* heap;  //wskaznik na tablice elementow kopca (storage.data())
+    std::size_t capacity; //pojemnosc tablicy
+    std::size_t size;    //aktualny rozmiar (liczba elementow)
+    InsertClock<Stability> insertCounter;  //Licznik wstawien dla realizacji FIFO
+    Compare compare;     //porownanie priorytetow
+    PriorityOffset<Priority> offset;  //globalne przesuniecie priorytetow (kopiec trzyma priorytet - offset)
+    Priority agingRate;  //przyrost priorytetu za tick oczekiwania (tryb starzenia, 0 - wylaczony)
+
+    //czy element a ma byc obsluzony przed b (wyzszy priorytet, przy rownych wczesniejszy czas wstawienia)
+    bool precedes(const HeapElement& a, const HeapElement& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return HeapElement::before(a, b);
+    }
 
-        HeapElement() : priority(0), insertTime(0) {}                     //czas wstawienia do kolejki (dla FIFO)
+    //funktor porownania przekazywany do silnika przesiewania (heap_sift.h)
+    struct Precedes {
+        const HeapPriorityQueue* queue;
 
-        HeapElement(int p, const T& v, unsigned long time)
-            : priority(p), value(v), insertTime(time) {}
+        bool operator()(const HeapElement& a, const HeapElement& b) const {
+            return queue->precedes(a, b);
+        }
     };
 
-    HeapElement* heap;  //dynamiczna tablica elementow kopca
-    int capacity;         //pojemnosc tablicy
-    int size;            //aktualny rozmiar (liczba elementow)
-    unsigned long insertCounter;       //Licznik wstawien dla realizacji FIFO
+    Precedes precedesFn() const {
+        Precedes fn = { this };
+        return fn;
+    }
 
-    //zmiana rozmiaru tablicy
-    void resize(int newCapacity) {
-        HeapElement* newHeap = new HeapElement[newCapacity];
+    //wolane przez silnik przesiewania przed zmiana elementu - leniwa migawka zachowuje jego strone
+    struct Touch {
+        const SharedBuffer<HeapElement>* storage;
 
-        //kopiowanie elementow do nowej tablicy
-        for (int i = 0; i < size; i++) {
-            newHeap[i] = heap[i];
+        void operator()(std::size_t index) const {
+            storage->beforeWrite(index);
         }
+    };
+
+    Touch touchFn() const {
+        Touch fn = { &storage };
+        return fn;
+    }
 
-        //zwalnianie starej tablicy i aktualizacja wskaznikow
-        delete[] heap;
-        heap = newHeap;
+    //zmiana rozmiaru tablicy (nowa tablica jest zawsze wlasna)
+    void resize(std::size_t newCapacity) {
+        storage.reallocate(size, newCapacity);
+        heap = storage.data();
         capacity = newCapacity;
     }
 
-   //przywraca wlasciwosc kopca 
-    void heapifyUp(int index) {
-        int parent = (index - 1) / 2;
+   //przywraca wlasciwosc kopca w gore (iteracyjnie, rodzice przesuwani w dol zamiast zamian)
+    void heapifyUp(std::size_t index) {
+        storage.beforeWrite(index);
+        siftUpHole(heap, index, std::move(heap[index]), precedesFn(), touchFn());
+    }
 
-        while (index > 0) {                           
-            if (heap[parent].priority < heap[index].priority) {//Jesli priorytet rodzica jest mniejszy  zamieniamy 
-                std::swap(heap[parent], heap[index]);
-                index = parent;
-                parent = (index - 1) / 2;
-            }
-            // Jesli priory są takie same  sprawdzamy czas wstawienia (FIFO)
-            else if (heap[parent].priority == heap[index].priority &&
-                heap[parent].insertTime > heap[index].insertTime) {
-                std::swap(heap[parent], heap[index]);
-                index = parent;
-                parent = (index - 1) / 2;
-            }
-            else {
-                break;  // wlasciwiosci  kopca zostaja takie same
+    //przywraca wlasciwosc kopca w dol (iteracyjnie, lepsze dziecko przesuwane w gore)
+    void heapifyDown(std::size_t index) {
+        storage.beforeWrite(index);
+        siftDownHole(heap, size, index, std::move(heap[index]), precedesFn(), touchFn());
+    }
+
+    //Floyd w obrebie poddrzewa o korzeniu root: poziomy od najglebszego wewnetrznego do korzenia,
+    //na kazdym poziomie wezly od prawej (wezly poddrzewa na glebokosci k sa w tablicy obok siebie)
+    void heapifySubtree(std::size_t root) {
+        std::size_t lastInternal = (size - 2) / 2;
+        if (root > lastInternal) {
+            return;
+        }
+
+        unsigned depth = 0;
+        while (((root + 1) << (depth + 1)) - 1 <= lastInternal) {
+            depth++;
+        }
+        for (unsigned k = depth + 1; k-- > 0;) {
+            std::size_t levelStart = ((root + 1) << k) - 1;
+            std::size_t levelEnd = std::min(levelStart + ((std::size_t)1 << k), lastInternal + 1);
+            for (std::size_t i = levelEnd; i-- > levelStart;) {
+                heapifyDown(i);
             }
         }
     }
 
-    void heapifyDown(int index) {
-        int largest = index;
-        int left = 2 * index + 1;
-        int right = 2 * index + 2;
-
-       //sprawdzamy  czy lewe dziecko ma wieksze priory lub rowny z wczesniejszym czasem wstawienia
-        if (left < size &&
-            (heap[left].priority > heap[largest].priority ||
-                (heap[left].priority == heap[largest].priority &&
-                    heap[left].insertTime < heap[largest].insertTime))) {
-            largest = left;
+    //budowa kopca w O(n): poddrzewa od poziomu podzialu sa niezalezne i przesiewane rownolegle
+    //(co najmniej 4 poddrzewa na watek), a gorne poziomy na koncu w jednym watku
+    void buildHeapOrder(unsigned threads) {
+        if (size < 2) {
+            return;
         }
 
-           //sprawdzamy  czy prawe dziecko ma wieksze priory lub rowny z wczesniejszym czasem wstawienia
-        if (right < size &&
-            (heap[right].priority > heap[largest].priority ||
-                (heap[right].priority == heap[largest].priority &&
-                    heap[right].insertTime < heap[largest].insertTime))) {
-            largest = right;
+        unsigned splitLevel = 0;
+        if (threads > 1) {
+            while (((std::size_t)1 << splitLevel) < (std::size_t)threads * 4 &&
+                ((std::size_t)2 << splitLevel) - 1 < size / 2) {
+                splitLevel++;
+            }
         }
 
-        // Jeśli znaleziono wiekszy element  zamieniamy i idziemy w dol
-        if (largest != index) {
-            std::swap(heap[index], heap[largest]);
-            heapifyDown(largest);
+        std::size_t firstRoot = ((std::size_t)1 << splitLevel) - 1;
+        parallelFor(firstRoot + 1, threads, [this, firstRoot](std::size_t r) {
+            heapifySubtree(firstRoot + r);
+        });
+        for (std::size_t i = firstRoot; i-- > 0;) {
+            heapifyDown(i);
         }
     }
 
-                                
-    int findElementIndex(const T& element) const {
-        for (int i = 0; i < size; i++) {                      //znajdowanie indeksu elementu
+    static const std::size_t notFound = (std::size_t)-1;   //wynik findElementIndex gdy brak elementu
+
+    std::size_t findElementIndex(const T& element) const {
+        for (std::size_t i = 0; i < size; i++) {                      //znajdowanie indeksu elementu
             if (heap[i].value == element) {
                 return i;
             }
         }
-        return -1; //Ni ma
+        return notFound; //Ni ma
+    }
+
+    //indeks wpisu o wartosci element i zapisanym priorytecie storedPriority
+    std::size_t findElementIndex(const T& element, const Priority& storedPriority) const {
+        for (std::size_t i = 0; i < size; i++) {
+            if (heap[i].value == element && !Order::higher(compare, heap[i].priority, storedPriority) &&
+                !Order::higher(compare, storedPriority, heap[i].priority)) {
+                return i;
+            }
+        }
+        return notFound;
+    }
+
+    //usuniecie elementu spod indeksu (false dla notFound) - ostatni element wchodzi na jego miejsce
+    //i jest przesiewany w gore albo w dol
+    bool removeAt(std::size_t index) {
+        if (index == notFound) {
+            return false;
+        }
+
+        detach();
+        size--;
+        if (index < size) {
+            storage.beforeWrite(index);
+            storage.beforeWrite(size);
+            heap[index] = std::move(heap[size]);
+            if (index > 0 && precedes(heap[index], heap[(index - 1) / 2])) {
+                heapifyUp(index);
+            }
+            else {
+                heapifyDown(index);
+            }
+        }
+        if (size == 0) {
+            offset.reset();
+        }
+
+        if (size > 0 && size <= capacity / 4) {
+            resize(capacity / 2);
+        }
+        return true;
     }
 
 public:
     //konstruktor
-    HeapPriorityQueue(int initialCapacity = 10) :
-        capacity(initialCapacity), size(0), insertCounter(0) {
-        heap = new HeapElement[capacity];
-    }
+    typedef QueueSnapshot<HeapElement, Priority, Compare> Snapshot;
 
-    
-    ~HeapPriorityQueue() {         //destruktor
-        delete[] heap;
+    HeapPriorityQueue(std::size_t initialCapacity = 10, const Compare& comparator = Compare()) :
+        storage(initialCapacity), heap(storage.data()), capacity(initialCapacity), size(0), compare(comparator),
+        agingRate() {
     }
 
     
-    HeapPriorityQueue(const HeapPriorityQueue& other) :           //konstruktor kopiuj
-        capacity(other.capacity), size(other.size), insertCounter(other.insertCounter) {
-        heap = new HeapElement[capacity];
-        for (int i = 0; i < size; i++) {
-            heap[i] = other.heap[i];
-        }
+    HeapPriorityQueue(const HeapPriorityQueue& other) :           //konstruktor kopiuj - O(1), tablica wspoldzielona
+        storage(other.storage), heap(storage.data()), capacity(other.capacity), size(other.size),
+        insertCounter(other.insertCounter), compare(other.compare), offset(other.offset), agingRate(other.agingRate) {
     }
 
     // Operator przypisania
     HeapPriorityQueue& operator=(const HeapPriorityQueue& other) {    
         if (this != &other) {
-            delete[] heap;
+            storage = other.storage;
+            heap = storage.data();
 
             capacity = other.capacity;
             size = other.size;
             insertCounter = other.insertCounter;
-
-            heap = new HeapElement[capacity];
-            for (int i = 0; i < size; i++) {
-                heap[i] = other.heap[i];
-            }
+            compare = other.compare;
+            offset = other.offset;
+            agingRate = other.agingRate;
         }
         return *this;
     }
 
+    //wlasna kopia tablicy, jesli jest wspoldzielona (wolane przez kazda modyfikacje)
+    void detach() {
+        if (storage.detach(size)) {
+            heap = storage.data();
+        }
+    }
+
+    //czy tablica jest wspoldzielona z kopia kolejki (migawki jej nie wspoldziela)
+    bool isShared() const {
+        return storage.isShared();
+    }
+
+    //migawka zawartosci w O(n / PAGE) bez kopiowania elementow - nie zmienia sie przy dalszych
+    //operacjach na kolejce, ktore kopiuja do niej tylko zmieniane strony (shared_buffer.h)
+    Snapshot snapshot() const {
+        return Snapshot(storage.pagedCopy(size), compare, offset);
+    }
+
     //dodaj element i jego priorytet
-    void insert(const T& element, int priority) {
+    void insert(const T& element, const Priority& priority) {
         
         if (size == capacity) {       //sprawdzamy czy trzeba wiecej miejsca
             resize(capacity * 2);
         }
+        else {
+            detach();
+        }
 
-        
-        heap[size] = HeapElement(priority, element, insertCounter++); // nowy element na koncu
+        storage.beforeWrite(size);
+        heap[size] = HeapElement(offset.toStored(priority), element, insertCounter.next()); // nowy element na koncu
 
         //przywroc wlasciwosci kopca
         heapifyUp(size);
         size++;
     }
 
+    //budowa hurtowa z tablic (zastepuje zawartosc kolejki) - O(n) zamiast O(n log n) wstawien
+    //elementy dostaja czasy wstawienia w kolejnosci tablic, jak przy kolejnych insert
+    void bulkLoad(const T* elements, const Priority* priorities, std::size_t count, unsigned threads = 1) {
+        std::size_t newCapacity = count > 10 ? count : 10;
+        storage = SharedBuffer<HeapElement>(newCapacity);
+        heap = storage.data();
+        capacity = newCapacity;
+        size = count;
+        offset.reset();
+
+        unsigned long long firstTime = insertCounter.reserve(count);
+        const std::size_t CHUNK = 1 << 16;
+        parallelFor((count + CHUNK - 1) / CHUNK, threads, [&](std::size_t c) {
+            std::size_t end = std::min(count, (c + 1) * CHUNK);
+            for (std::size_t i = c * CHUNK; i < end; i++) {
+                heap[i] = HeapElement(offset.toStored(priorities[i]), elements[i], firstTime + i);
+            }
+        });
+
+        buildHeapOrder(threads);
+    }
+
     //usun element z najwiekszym priorytetem
     T extractMax() {
         if (size == 0) {
             throw std::runtime_error("Kolejka jest pusta");
         }
 
-        T maxElement = heap[0].value;
+        detach();
+        storage.beforeWrite(0);
+        T maxElement = std::move(heap[0].value);
 
-        //przenies ostatni element na poczatek i zmniejsz rozmiar
-        heap[0] = heap[size - 1];
+        //dziura po korzeniu schodzi do liscia, potem ostatni element jest przesiewany w gore (Floyd)
+        popRootBottomUp(heap, size, precedesFn(), touchFn());
         size--;
-
-        //Przywroc wlasnoci kopca
-        if (size > 0) {
-            heapifyDown(0);
+        if (size == 0) {
+            offset.reset();   //pusta kolejka - przesuniecie nie dotyczy juz zadnego elementu
         }
 
         //Zmniejsz pojemnosc jeśli jest dużo niewykorzystanego miejsca
@@ -178,6 +301,18 @@ public:
         return maxElement;
     }
 
+    //usuniecie wskazanego elementu (false, gdy go nie ma) - ostatni element wchodzi na jego miejsce
+    //i jest przesiewany w gore albo w dol
+    bool remove(const T& element) {
+        return removeAt(findElementIndex(element));
+    }
+
+    //usuniecie wpisu o podanej wartosci i priorytecie - przy powtarzajacych sie wartosciach
+    //wskazuje wpis dokladniej niz sama wartosc
+    bool remove(const T& element, const Priority& priority) {
+        return removeAt(findElementIndex(element, offset.toStored(priority)));
+    }
+
     
     T findMax() const {
         if (size == 0) {                             
@@ -186,68 +321,137 @@ public:
         return heap[0].value;                         //poka element z maksymalnym priorytetem
     }
 
+    //priorytet elementu z maksymalnym priorytetem
+    Priority findMaxPriority() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return offset.toEffective(heap[0].priority);
+    }
+
     
-    int getPriority(const T& element) const {
-        int index = findElementIndex(element);
-        if (index == -1) {
+    Priority getPriority(const T& element) const {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
             throw std::runtime_error("Nie znaleziono elementu");           //pokaz priorytet konkretnego elementu
         }
-        return heap[index].priority;
+        return offset.toEffective(heap[index].priority);
     }
 
     
-    void modifyKey(const T& element, int newPriority) {
-        int index = findElementIndex(element);
-        if (index == -1) {                            //zmien priorytet elementu
+    void modifyKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {                            //zmien priorytet elementu
             throw std::runtime_error("Nie znaleziono takiego elementu");
         }
 
-        int oldPriority = heap[index].priority;
-        heap[index].priority = newPriority;
+        detach();
+        Priority oldPriority = heap[index].priority;
+        Priority storedPriority = offset.toStored(newPriority);
+        storage.beforeWrite(index);
+        heap[index].priority = storedPriority;
 
-        if (newPriority > oldPriority) {
+        if (Order::higher(compare, storedPriority, oldPriority)) {
             heapifyUp(index);
         }
-        else if (newPriority < oldPriority) {
+        else if (Order::higher(compare, oldPriority, storedPriority)) {
             heapifyDown(index);
         }
     }
 
     //zwieksz priorytet
-    void increaseKey(const T& element, int newPriority) {
-        int index = findElementIndex(element);
-        if (index == -1) {
+    void increaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
             throw std::runtime_error("Nie znaleziono takiego elementu");
         }
 
-        if (newPriority <= heap[index].priority) {
+        Priority storedPriority = offset.toStored(newPriority);
+        if (!Order::higher(compare, storedPriority, heap[index].priority)) {
             throw std::runtime_error("Nowy priorytet musi byc wiekszy niz stary");
         }
 
-        heap[index].priority = newPriority;
+        detach();
+        storage.beforeWrite(index);
+        heap[index].priority = storedPriority;
         heapifyUp(index);
     }
 
     //zmniejsz priorytet
-    void decreaseKey(const T& element, int newPriority) {
-        int index = findElementIndex(element);
-        if (index == -1) {
+    void decreaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
             throw std::runtime_error("Nie znaleziono takiego elementu");
         }
 
-        if (newPriority >= heap[index].priority) {
+        Priority storedPriority = offset.toStored(newPriority);
+        if (!Order::higher(compare, heap[index].priority, storedPriority)) {
             throw std::runtime_error("Nowy priorytet musi byc mniejszy niz stary");
         }
 
-        heap[index].priority = newPriority;
+        detach();
+        storage.beforeWrite(index);
+        heap[index].priority = storedPriority;
         heapifyDown(index);
     }
 
+    //zmiana priorytetu wszystkich elementow o delta w O(1) - przesuwa sie tylko offset, porzadek kopca
+    //zostaje (tylko typy priorytetu ze znakiem); gdy offset przekroczylby polowe zakresu typu,
+    //przesuniecie jest wliczane do zapisanych priorytetow w O(n) (zamortyzowane O(1))
+    void shiftAllPriorities(const Priority& delta) {
+        if (!offset.tryShift(delta)) {
+            rebasePriorities(delta);
+        }
+    }
+
+    //wliczenie offsetu i delta do zapisanych priorytetow, offset wraca do zera - dodanie stalej
+    //do wszystkich priorytetow nie zmienia porzadku kopca
+    void rebasePriorities(const Priority& delta) {
+        detach();
+        for (std::size_t i = 0; i < size; i++) {
+            storage.beforeWrite(i);
+            heap[i].priority = offset.toEffective(heap[i].priority) + delta;
+        }
+        offset.reset();
+    }
+
+    //tryb starzenia: priorytet efektywny = priorytet przy wstawieniu + rate * liczba tickow oczekiwania
+    //element wstawiony pozniej dostaje priorytet zapisany wzgledem aktualnego offsetu, wiec kazdy tick
+    //to shiftAllPriorities(rate) - kopiec sie nie zmienia (dla Compare = std::greater podaj rate ujemne)
+    void setAgingRate(const Priority& rate) {
+        agingRate = rate;
+    }
+
+    Priority returnAgingRate() const {
+        return agingRate;
+    }
+
+    //uplyw ticks tickow czasu oczekiwania
+    void advanceAge(unsigned long long ticks = 1) {
+        shiftAllPriorities(agingRate * static_cast<Priority>(ticks));
+    }
+
+    //biezace przesuniecie zapisanych priorytetow (zerowane, gdy kolejka sie oprozni albo gdy
+    //przesuniecie jest wliczane do priorytetow)
+    Priority returnPriorityOffset() const {
+        return offset.toEffective(Priority());
+    }
+
     
-    int returnSize() const { //pokaz rozmiar
+    std::size_t returnSize() const { //pokaz rozmiar
         return size;
     }
 
+    //pokaz pojemnosc (liczba zaalokowanych miejsc)
+    std::size_t returnCapacity() const {
+        return capacity;
+    }
+
+    //pamiec zajmowana przez tablice kopca (w bajtach)
+    std::size_t memoryUsage() const {
+        return capacity * sizeof(HeapElement);
+    }
+
     // czy pusta
     bool isEmpty() const {
         return size == 0;
@@ -256,19 +460,24 @@ public:
     //wyczysc kolejke
     void clear() {
         size = 0;
+        offset.reset();
         
         if (capacity > 10) {     // jesli trzeba zwieksz pojemnosc
             resize(10);
         }
+        else {
+            detach();
+        }
     }
 
    
     void print() const {
         std::cout << "Kolejka Priorytetowa (Kopiec): " << std::endl;    //pokaz zawartosc kolejki
-        for (int i = 0; i < size; i++) {
-            std::cout << "Priorytet: " << heap[i].priority
-                << ", Element: " << heap[i].value
-                << ", Czas wstawienia: " << heap[i].insertTime << std::endl;
+        for (std::size_t i = 0; i < size; i++) {
+            std::cout << "Priorytet: " << offset.toEffective(heap[i].priority)
+                << ", Element: " << heap[i].value;
+            heap[i].printInsertTime(std::cout);
+            std::cout << std::endl;
         }
     }
 };
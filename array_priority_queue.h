@@ -3,102 +3,180 @@
 
 #include <stdexcept>
 #include <iostream>
-
-template <typename T>
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include "priority_order.h"
+#include "shared_buffer.h"
+#include "parallel_tasks.h"
+
+//Priority - typ priorytetu, Compare - porządek jak w std::priority_queue (domyślnie największy pierwszy)
+//Stability - StableOrder (FIFO przy równych priorytetach) albo UnstableOrder (bez czasu wstawienia)
+//kopie kolejki współdzielą tablicę (copy-on-write) aż do pierwszej modyfikacji
+template <typename T, typename Priority = int, typename Compare = std::less<Priority>, typename Stability = StableOrder>
 class ArrayPriorityQueue {
 private:
-    //struktura przechowująca element, jego priorytet i czas wstawienia
-    struct Element {
-        int priority;
-        T value;
-        unsigned long insertTime;  //czas wstawienia do kolejki (dla FIFO)
-
-        Element() : priority(0), insertTime(0) {}
-
-        Element(int p, const T& v, unsigned long time)
-            : priority(p), value(v), insertTime(time) {}
-    };
-
-    Element* elements;  //dynamiczna tablica elementów
-    int capacity;       //pojemność tablicy
-    int size;           //aktualny rozmiar (liczba elementów)
-    unsigned long insertCounter;  //licznik wstawień dla realizacji FIFO
-
-    //zmiana rozmiaru tablicy
-    void resize(int newCapacity) {
-        Element* newElements = new Element[newCapacity];
-
-        //kopiowanie elementów do nowej tablicy
-        for (int i = 0; i < size; i++) {
-            newElements[i] = elements[i];
+    typedef PriorityOrder<Priority, Compare> Order;
+
+    //struktura przechowująca element, jego priorytet i czas wstawienia (tylko w trybie stabilnym)
+    typedef PriorityEntry<T, Priority, Stability> Element;
+
+    SharedBuffer<Element> storage;  //tablica współdzielona z kopiami (migawki kopiowane leniwie stronami)
+    Element* elements;  //wskaźnik na tablicę elementów (storage.data())
+    std::size_t capacity; //pojemność tablicy
+    std::size_t size;   //aktualny rozmiar (liczba elementów)
+    InsertClock<Stability> insertCounter; //licznik wstawień dla realizacji FIFO
+    Compare compare;    //porównanie priorytetów
+    PriorityOffset<Priority> offset;  //globalne przesunięcie priorytetów (tablica trzyma priorytet - offset)
+    Priority agingRate; //przyrost priorytetu za tick oczekiwania (tryb starzenia, 0 - wyłączony)
+
+    //czy element a ma być obsłużony przed b (wyższy priorytet, przy równych wcześniejszy czas wstawienia)
+    bool precedes(const Element& a, const Element& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
         }
+        return Element::before(a, b);
+    }
 
-        //zwalnianie starej tablicy i aktualizacja wskaźników
-        delete[] elements;
-        elements = newElements;
+    //zmiana rozmiaru tablicy (nowa tablica jest zawsze własna)
+    void resize(std::size_t newCapacity) {
+        storage.reallocate(size, newCapacity);
+        elements = storage.data();
         capacity = newCapacity;
     }
 
+    static const std::size_t notFound = (std::size_t)-1;  //wynik findElementIndex gdy brak elementu
+
     //znajdowanie indeksu elementu o określonej wartości
-    int findElementIndex(const T& element) const {
-        for (int i = 0; i < size; i++) {
+    std::size_t findElementIndex(const T& element) const {
+        for (std::size_t i = 0; i < size; i++) {
             if (elements[i].value == element) {
                 return i;
             }
         }
-        return -1; //element nie znaleziony
+        return notFound; //element nie znaleziony
+    }
+
+    //indeks wpisu o wartości element i zapisanym priorytecie storedPriority
+    std::size_t findElementIndex(const T& element, const Priority& storedPriority) const {
+        for (std::size_t i = 0; i < size; i++) {
+            if (elements[i].value == element && !Order::higher(compare, elements[i].priority, storedPriority) &&
+                !Order::higher(compare, storedPriority, elements[i].priority)) {
+                return i;
+            }
+        }
+        return notFound;
+    }
+
+    //usuń element spod indeksu (false dla notFound) - zamiana z ostatnim, jak w extractMax
+    bool removeAt(std::size_t index) {
+        if (index == notFound) {
+            return false;
+        }
+
+        detach();
+        storage.beforeWrite(index);
+        elements[index] = elements[size - 1];
+        size--;
+        if (size == 0) {
+            offset.reset();
+        }
+
+        if (size > 0 && size <= capacity / 4) {
+            resize(capacity / 2);
+        }
+        return true;
     }
 
 public:
     //konstruktor
-    ArrayPriorityQueue(int initialCapacity = 10) :
-        capacity(initialCapacity), size(0), insertCounter(0) {
-        elements = new Element[capacity];
-    }
+    typedef QueueSnapshot<Element, Priority, Compare> Snapshot;
 
-    //destruktor
-    ~ArrayPriorityQueue() {
-        delete[] elements;
+    ArrayPriorityQueue(std::size_t initialCapacity = 10, const Compare& comparator = Compare()) :
+        storage(initialCapacity), elements(storage.data()), capacity(initialCapacity), size(0), compare(comparator),
+        agingRate() {
     }
 
-    //konstruktor kopiujący
+    //konstruktor kopiujący - O(1), tablica współdzielona do pierwszej modyfikacji
     ArrayPriorityQueue(const ArrayPriorityQueue& other) :
-        capacity(other.capacity), size(other.size), insertCounter(other.insertCounter) {
-        elements = new Element[capacity];
-        for (int i = 0; i < size; i++) {
-            elements[i] = other.elements[i];
-        }
+        storage(other.storage), elements(storage.data()), capacity(other.capacity), size(other.size),
+        insertCounter(other.insertCounter), compare(other.compare), offset(other.offset), agingRate(other.agingRate) {
     }
 
     //operator przypisania
     ArrayPriorityQueue& operator=(const ArrayPriorityQueue& other) {
         if (this != &other) {
-            delete[] elements;
+            storage = other.storage;
+            elements = storage.data();
 
             capacity = other.capacity;
             size = other.size;
             insertCounter = other.insertCounter;
-
-            elements = new Element[capacity];
-            for (int i = 0; i < size; i++) {
-                elements[i] = other.elements[i];
-            }
+            compare = other.compare;
+            offset = other.offset;
+            agingRate = other.agingRate;
         }
         return *this;
     }
 
+    //własna kopia tablicy, jeśli jest współdzielona (wołane przez każdą modyfikację)
+    void detach() {
+        if (storage.detach(size)) {
+            elements = storage.data();
+        }
+    }
+
+    //czy tablica jest współdzielona z kopią kolejki (migawki jej nie współdzielą)
+    bool isShared() const {
+        return storage.isShared();
+    }
+
+    //migawka zawartości w O(n / PAGE) bez kopiowania elementów - dalsze operacje kopiują do niej
+    //tylko zmieniane strony (shared_buffer.h)
+    Snapshot snapshot() const {
+        return Snapshot(storage.pagedCopy(size), compare, offset);
+    }
+
     //wstawianie elementu z priorytetem
-    void insert(const T& element, int priority) {
+    void insert(const T& element, const Priority& priority) {
         //sprawdź, czy potrzebujemy więcej miejsca
         if (size == capacity) {
             resize(capacity * 2);
         }
+        else {
+            detach();
+        }
 
         //dodaj nowy element na końcu
-        elements[size] = Element(priority, element, insertCounter++);
+        storage.beforeWrite(size);
+        elements[size] = Element(offset.toStored(priority), element, insertCounter.next());
         size++;
     }
 
+    //wczytanie hurtowe z tablic (zastępuje zawartość kolejki) - tablica nie wymaga porządku,
+    //więc to tylko równoległe kopiowanie; czasy wstawienia w kolejności tablic, jak przy insert
+    void bulkLoad(const T* values, const Priority* priorities, std::size_t count, unsigned threads = 1) {
+        std::size_t newCapacity = count > 10 ? count : 10;
+        storage = SharedBuffer<Element>(newCapacity);
+        elements = storage.data();
+        capacity = newCapacity;
+        size = count;
+        offset.reset();
+
+        unsigned long long firstTime = insertCounter.reserve(count);
+        const std::size_t CHUNK = 1 << 16;
+        Element* target = elements;
+        parallelFor((count + CHUNK - 1) / CHUNK, threads, [&](std::size_t c) {
+            std::size_t end = std::min(count, (c + 1) * CHUNK);
+            for (std::size_t i = c * CHUNK; i < end; i++) {
+                target[i] = Element(offset.toStored(priorities[i]), values[i], firstTime + i);
+            }
+        });
+    }
+
     //usunięcie i zwrócenie elementu o najwyższym priorytecie
     T extractMax() {
         if (size == 0) {
@@ -106,20 +184,23 @@ public:
         }
 
         //znajdź element o najwyższym priorytecie, przy równych priorytetach wybierz ten, który został wstawiony wcześniej (FIFO)
-        int maxIndex = 0;
-        for (int i = 1; i < size; i++) {
-            if (elements[i].priority > elements[maxIndex].priority ||
-                (elements[i].priority == elements[maxIndex].priority &&
-                    elements[i].insertTime < elements[maxIndex].insertTime)) {
+        std::size_t maxIndex = 0;
+        for (std::size_t i = 1; i < size; i++) {
+            if (precedes(elements[i], elements[maxIndex])) {
                 maxIndex = i;
             }
         }
 
+        detach();
         T maxElement = elements[maxIndex].value;
 
         //usuń element zamieniając go z ostatnim elementem i zmniejszając rozmiar
+        storage.beforeWrite(maxIndex);
         elements[maxIndex] = elements[size - 1];
         size--;
+        if (size == 0) {
+            offset.reset();   //pusta kolejka - przesunięcie nie dotyczy już żadnego elementu
+        }
 
         //zmniejsz pojemność, jeśli jest dużo niewykorzystanego miejsca
         if (size > 0 && size <= capacity / 4) {
@@ -129,17 +210,26 @@ public:
         return maxElement;
     }
 
+    //usuń wskazany element (false, gdy go nie ma) - zamiana z ostatnim, jak w extractMax
+    bool remove(const T& element) {
+        return removeAt(findElementIndex(element));
+    }
+
+    //usuń wpis o podanej wartości i priorytecie - przy powtarzających się wartościach
+    //wskazuje wpis dokładniej niż sama wartość
+    bool remove(const T& element, const Priority& priority) {
+        return removeAt(findElementIndex(element, offset.toStored(priority)));
+    }
+
     //zwróć element o najwyższym priorytecie bez usuwania
     T findMax() const {
         if (size == 0) {
             throw std::runtime_error("Kolejka jest pusta");
         }
 
-        int maxIndex = 0;
-        for (int i = 1; i < size; i++) {
-            if (elements[i].priority > elements[maxIndex].priority ||
-                (elements[i].priority == elements[maxIndex].priority &&
-                    elements[i].insertTime < elements[maxIndex].insertTime)) {
+        std::size_t maxIndex = 0;
+        for (std::size_t i = 1; i < size; i++) {
+            if (precedes(elements[i], elements[maxIndex])) {
                 maxIndex = i;
             }
         }
@@ -147,58 +237,132 @@ public:
         return elements[maxIndex].value;
     }
 
+    //zwróć najwyższy priorytet w kolejce
+    Priority findMaxPriority() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+
+        std::size_t maxIndex = 0;
+        for (std::size_t i = 1; i < size; i++) {
+            if (precedes(elements[i], elements[maxIndex])) {
+                maxIndex = i;
+            }
+        }
+
+        return offset.toEffective(elements[maxIndex].priority);
+    }
+
     //pobierz priorytet określonego elementu
-    int getPriority(const T& element) const {
-        int index = findElementIndex(element);
-        if (index == -1) {
+    Priority getPriority(const T& element) const {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
             throw std::runtime_error("Element nie znaleziony w kolejce");
         }
-        return elements[index].priority;
+        return offset.toEffective(elements[index].priority);
     }
 
     //zmień priorytet elementu
-    void modifyKey(const T& element, int newPriority) {
-        int index = findElementIndex(element);
-        if (index == -1) {
+    void modifyKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
             throw std::runtime_error("Element nie znaleziony w kolejce");
         }
 
-        elements[index].priority = newPriority;
+        detach();
+        storage.beforeWrite(index);
+        elements[index].priority = offset.toStored(newPriority);
     }
 
     //zwiększ priorytet elementu
-    void increaseKey(const T& element, int newPriority) {
-        int index = findElementIndex(element);
-        if (index == -1) {
+    void increaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
             throw std::runtime_error("Element nie znaleziony w kolejce");
         }
 
-        if (newPriority <= elements[index].priority) {
+        Priority storedPriority = offset.toStored(newPriority);
+        if (!Order::higher(compare, storedPriority, elements[index].priority)) {
             throw std::runtime_error("Nowy priorytet musi byc wiekszy niz obecny");
         }
 
-        elements[index].priority = newPriority;
+        detach();
+        storage.beforeWrite(index);
+        elements[index].priority = storedPriority;
     }
 
     //zmniejsz priorytet elementu
-    void decreaseKey(const T& element, int newPriority) {
-        int index = findElementIndex(element);
-        if (index == -1) {
+    void decreaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
             throw std::runtime_error("Element nie znaleziony w kolejce");
         }
 
-        if (newPriority >= elements[index].priority) {
+        Priority storedPriority = offset.toStored(newPriority);
+        if (!Order::higher(compare, elements[index].priority, storedPriority)) {
             throw std::runtime_error("Nowy priorytet musi byc mniejszy niz obecny");
         }
 
-        elements[index].priority = newPriority;
+        detach();
+        storage.beforeWrite(index);
+        elements[index].priority = storedPriority;
+    }
+
+    //zmiana priorytetu wszystkich elementów o delta w O(1) - przesuwa się tylko offset
+    //(tylko typy priorytetu ze znakiem); gdy offset przekroczyłby połowę zakresu typu,
+    //przesunięcie jest wliczane do zapisanych priorytetów w O(n) (zamortyzowane O(1))
+    void shiftAllPriorities(const Priority& delta) {
+        if (!offset.tryShift(delta)) {
+            rebasePriorities(delta);
+        }
+    }
+
+    //wliczenie offsetu i delta do zapisanych priorytetów, offset wraca do zera
+    void rebasePriorities(const Priority& delta) {
+        detach();
+        for (std::size_t i = 0; i < size; i++) {
+            storage.beforeWrite(i);
+            elements[i].priority = offset.toEffective(elements[i].priority) + delta;
+        }
+        offset.reset();
+    }
+
+    //tryb starzenia jak w HeapPriorityQueue: priorytet efektywny = priorytet przy wstawieniu
+    //+ rate * liczba ticków oczekiwania, każdy tick to shiftAllPriorities(rate)
+    void setAgingRate(const Priority& rate) {
+        agingRate = rate;
+    }
+
+    Priority returnAgingRate() const {
+        return agingRate;
+    }
+
+    //upływ ticks ticków czasu oczekiwania
+    void advanceAge(unsigned long long ticks = 1) {
+        shiftAllPriorities(agingRate * static_cast<Priority>(ticks));
+    }
+
+    //bieżące przesunięcie zapisanych priorytetów (zerowane, gdy kolejka się opróżni albo gdy
+    //przesunięcie jest wliczane do priorytetów)
+    Priority returnPriorityOffset() const {
+        return offset.toEffective(Priority());
     }
 
     //zwróć rozmiar kolejki priorytetowej
-    int returnSize() const {
+    std::size_t returnSize() const {
         return size;
     }
 
+    //zwróć pojemność (liczba zaalokowanych miejsc)
+    std::size_t returnCapacity() const {
+        return capacity;
+    }
+
+    //pamięć zajmowana przez tablicę elementów (w bajtach)
+    std::size_t memoryUsage() const {
+        return capacity * sizeof(Element);
+    }
+
     //sprawdź czy kolejka jest pusta
     bool isEmpty() const {
         return size == 0;
@@ -207,18 +371,23 @@ public:
     //wyczyść kolejkę
     void clear() {
         size = 0;
+        offset.reset();
         if (capacity > 10) {
             resize(10);
         }
+        else {
+            detach();
+        }
     }
 
     //wyświetl zawartość kolejki
     void print() const {
         std::cout << "Kolejka Priorytetowa (Tablica): " << std::endl;
-        for (int i = 0; i < size; i++) {
-            std::cout << "Priorytet: " << elements[i].priority
-                << ", Element: " << elements[i].value
-                << ", Czas wstawienia: " << elements[i].insertTime << std::endl;
+        for (std::size_t i = 0; i < size; i++) {
+            std::cout << "Priorytet: " << offset.toEffective(elements[i].priority)
+                << ", Element: " << elements[i].value;
+            elements[i].printInsertTime(std::cout);
+            std::cout << std::endl;
         }
     }
 };
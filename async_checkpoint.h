@@ -0,0 +1,106 @@
+#ifndef ASYNC_CHECKPOINT_H
+#define ASYNC_CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <functional>
+#include <future>
+#include <algorithm>
+#include <sstream>
+#include "parallel_tasks.h"
+#include "file_replace.h"
+
+//zapis migawki kolejki do pliku tekstowego "element priorytet" od najwyzszego priorytetu
+//(format zapiszDoPliku/wczytajZPliku); O(n log n) - kopia elementow i sortowanie zamiast
+//wielokrotnego findMax/getPriority/extractMax
+//przy threads > 1 sortowanie jest rownolegle, a tekst kolejnych blokow jest formatowany
+//rownolegle we fragmentach i zapisywany po kolei
+//plik powstaje jako tymczasowy i dopiero po pelnym zapisie i fsync zastepuje docelowy (atomowo -
+//po awarii zostaje poprzedni albo nowy zapis)
+template <typename Snapshot>
+bool writeSnapshotFile(const Snapshot& snapshot, const std::string& path, unsigned threads = 1) {
+    typedef typename Snapshot::value_type Entry;
+    const std::size_t FORMAT_BLOCK = (std::size_t)1 << 20;     //elementy formatowane naraz (pamiec na tekst)
+
+    const std::size_t count = snapshot.size();
+    Entry* sorted = new Entry[count > 0 ? count : 1];
+    parallelFor((count + FORMAT_BLOCK - 1) / FORMAT_BLOCK, threads, [&](std::size_t b) {
+        std::size_t begin = b * FORMAT_BLOCK;
+        std::size_t end = std::min(count, begin + FORMAT_BLOCK);
+        snapshot.copyTo(begin, end, sorted + begin);
+    });
+    parallelSort(sorted, count, snapshot.precedesFn(), threads);
+
+    std::string temporaryPath = path + ".tmp";
+    bool success;
+    {
+        std::FILE* file = std::fopen(temporaryPath.c_str(), "w");
+        if (file == nullptr) {
+            delete[] sorted;
+            return false;
+        }
+
+        const std::size_t PARTS = threads > 1 ? threads * 4 : 1;
+        std::string* texts = new std::string[PARTS];
+        for (std::size_t blockStart = 0; blockStart < count; blockStart += FORMAT_BLOCK) {
+            std::size_t blockEnd = std::min(count, blockStart + FORMAT_BLOCK);
+            std::size_t partSize = (blockEnd - blockStart + PARTS - 1) / PARTS;
+            parallelFor(PARTS, threads, [&](std::size_t part) {
+                std::size_t begin = std::min(blockEnd, blockStart + part * partSize);
+                std::size_t end = std::min(blockEnd, begin + partSize);
+                std::ostringstream text;
+                for (std::size_t i = begin; i < end; i++) {
+                    text << sorted[i].value << " " << snapshot.priorityOf(sorted[i]) << "\n";
+                }
+                texts[part] = text.str();
+            });
+            for (std::size_t part = 0; part < PARTS; part++) {
+                std::fwrite(texts[part].data(), 1, texts[part].size(), file);
+            }
+        }
+        delete[] texts;
+
+        success = !std::ferror(file) && syncToDisk(file);
+        success = std::fclose(file) == 0 && success;
+    }
+    delete[] sorted;
+
+    if (!success) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    if (!replaceFile(temporaryPath, path)) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+//zapis w tle (checkpoint): migawka jest pobierana w O(n / PAGE) bez kopiowania elementow w watku
+//wolajacym - musi to byc watek, ktory modyfikuje kolejke - a kopiowanie, sortowanie i zapis wykonuje
+//osobny watek; kolejka dziala dalej bez blokad, a modyfikacja przed skopiowaniem zmienianej strony
+//kopiuje tylko te strone (PAGE elementow), wiec opoznienie nie rosnie z rozmiarem kolejki
+//migawka jest zwalniana po zakonczeniu zapisu
+//wynik (czy zapis sie udal) zwraca future, a opcjonalnie takze onComplete wolane w watku zapisu
+template <typename Queue>
+std::future<bool> saveAsync(const Queue& queue, const std::string& path, unsigned threads = 1,
+    std::function<void(bool)> onComplete = std::function<void(bool)>()) {
+    typename Queue::Snapshot snapshot = queue.snapshot();
+
+    return std::async(std::launch::async, [snapshot, path, threads, onComplete]() {
+        bool success;
+        try {
+            success = writeSnapshotFile(snapshot, path, threads);
+        }
+        catch (...) {
+            success = false;
+        }
+        if (onComplete) {
+            onComplete(success);
+        }
+        return success;
+    });
+}
+
+#endif // ASYNC_CHECKPOINT_H
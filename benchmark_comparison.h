@@ -0,0 +1,420 @@
+#ifndef BENCHMARK_COMPARISON_H
+#define BENCHMARK_COMPARISON_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+//wyniki testow wydajnosci w postaci do porownywania miedzy przebiegami (np. przed i po zmianie
+//naglowkow kolejek): wszystkie pojedyncze pomiary (ns) dla kazdej trojki (kolejka, rozmiar, operacja)
+//zapis: CSV w formacie dlugim (jeden pomiar na wiersz) i JSON z informacja o kompilacji i ziarnie
+//porownanie: test Manna-Whitneya (rangowy - odporny na rzadkie skoki czasu) dla kazdej trojki;
+//regresja = kandydat istotnie wolniejszy (p < alpha) i mediana gorsza o wiecej niz prog (procentowy
+//i bezwzgledny - pojedyncze operacje trwaja kilkadziesiat ns, tyle co sam odczyt zegara)
+//pomiary jednego przebiegu dziela stan maszyny (czestotliwosc, inne procesy), wiec test wykrywa tez
+//roznice miedzy przebiegami, a nie tylko miedzy wersjami kodu - porownuj przebiegi z tej samej,
+//nieobciazonej maszyny i dobierz prog do rozrzutu dwoch przebiegow tej samej wersji
+
+//informacja o kompilacji zapisywana razem z wynikami
+struct BuildInfo {
+    std::string compiler;
+    std::string standard;
+    std::string optimization;
+    std::string platform;
+};
+
+inline BuildInfo currentBuildInfo() {
+    BuildInfo info;
+#if defined(__clang__)
+    info.compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    info.compiler = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    info.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    info.compiler = "nieznany";
+#endif
+
+#if defined(_MSVC_LANG)
+    info.standard = std::to_string(_MSVC_LANG);
+#else
+    info.standard = std::to_string(__cplusplus);
+#endif
+
+#if defined(__OPTIMIZE__) || (defined(_MSC_VER) && defined(NDEBUG))
+    info.optimization = "optymalizacja";
+#else
+    info.optimization = "bez optymalizacji";
+#endif
+#ifdef NDEBUG
+    info.optimization += ", NDEBUG";
+#endif
+
+#if defined(_WIN32)
+    info.platform = "windows";
+#elif defined(__APPLE__)
+    info.platform = "macos";
+#elif defined(__linux__)
+    info.platform = "linux";
+#else
+    info.platform = "inna";
+#endif
+    return info;
+}
+
+//pomiary jednej operacji dla jednej kolejki i rozmiaru
+class BenchmarkSeries {
+private:
+    std::string queueName;
+    int sizeValue;
+    std::string operationName;
+    double* samples;
+    std::size_t count;
+    std::size_t capacity;
+
+public:
+    BenchmarkSeries(const std::string& queue, int size, const std::string& operation) :
+        queueName(queue), sizeValue(size), operationName(operation), count(0), capacity(16) {
+        samples = new double[capacity];
+    }
+
+    ~BenchmarkSeries() {
+        delete[] samples;
+    }
+
+    BenchmarkSeries(const BenchmarkSeries&) = delete;
+    BenchmarkSeries& operator=(const BenchmarkSeries&) = delete;
+
+    void record(double value) {
+        if (count == capacity) {
+            double* larger = new double[capacity * 2];
+            std::copy(samples, samples + count, larger);
+            delete[] samples;
+            samples = larger;
+            capacity *= 2;
+        }
+        samples[count++] = value;
+    }
+
+    bool matches(const std::string& queue, int size, const std::string& operation) const {
+        return sizeValue == size && operationName == operation && queueName == queue;
+    }
+
+    const std::string& queue() const {
+        return queueName;
+    }
+
+    int size() const {
+        return sizeValue;
+    }
+
+    const std::string& operation() const {
+        return operationName;
+    }
+
+    std::size_t sampleCount() const {
+        return count;
+    }
+
+    const double* data() const {
+        return samples;
+    }
+
+    double mean() const {
+        double sum = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            sum += samples[i];
+        }
+        return count > 0 ? sum / count : 0;
+    }
+
+    double median() const {
+        if (count == 0) {
+            return 0;
+        }
+        double* sorted = new double[count];
+        std::copy(samples, samples + count, sorted);
+        std::sort(sorted, sorted + count);
+        double result = count % 2 == 1 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+        delete[] sorted;
+        return result;
+    }
+};
+
+//wszystkie serie jednego przebiegu testow
+class BenchmarkResults {
+private:
+    BenchmarkSeries** series;
+    std::size_t count;
+    std::size_t capacity;
+
+    static std::string escapeJson(const std::string& text) {
+        std::string result;
+        for (std::size_t i = 0; i < text.size(); i++) {
+            if (text[i] == '"' || text[i] == '\\') {
+                result += '\\';
+            }
+            result += text[i];
+        }
+        return result;
+    }
+
+public:
+    static const char* csvHeader() {
+        return "Kolejka,Rozmiar,Operacja,Pomiar,Czas(ns)";
+    }
+
+    BenchmarkResults() : count(0), capacity(16) {
+        series = new BenchmarkSeries*[capacity];
+    }
+
+    ~BenchmarkResults() {
+        for (std::size_t i = 0; i < count; i++) {
+            delete series[i];
+        }
+        delete[] series;
+    }
+
+    BenchmarkResults(const BenchmarkResults&) = delete;
+    BenchmarkResults& operator=(const BenchmarkResults&) = delete;
+
+    //seria dla trojki (tworzona przy pierwszym uzyciu) - pobierz raz przed petla pomiarow
+    BenchmarkSeries& get(const std::string& queue, int size, const std::string& operation) {
+        BenchmarkSeries* existing = find(queue, size, operation);
+        if (existing != nullptr) {
+            return *existing;
+        }
+        if (count == capacity) {
+            BenchmarkSeries** larger = new BenchmarkSeries*[capacity * 2];
+            std::copy(series, series + count, larger);
+            delete[] series;
+            series = larger;
+            capacity *= 2;
+        }
+        series[count] = new BenchmarkSeries(queue, size, operation);
+        return *series[count++];
+    }
+
+    BenchmarkSeries* find(const std::string& queue, int size, const std::string& operation) const {
+        for (std::size_t i = 0; i < count; i++) {
+            if (series[i]->matches(queue, size, operation)) {
+                return series[i];
+            }
+        }
+        return nullptr;
+    }
+
+    std::size_t seriesCount() const {
+        return count;
+    }
+
+    const BenchmarkSeries& at(std::size_t index) const {
+        return *series[index];
+    }
+
+    //CSV w formacie dlugim: naglowek i jeden pomiar na wiersz (bez sekcji i komentarzy)
+    void writeCsv(std::ostream& out) const {
+        out << csvHeader() << "\n";
+        for (std::size_t i = 0; i < count; i++) {
+            const BenchmarkSeries& s = *series[i];
+            for (std::size_t j = 0; j < s.sampleCount(); j++) {
+                out << s.queue() << "," << s.size() << "," << s.operation() << "," << j << "," << s.data()[j] << "\n";
+            }
+        }
+    }
+
+    //JSON: informacja o kompilacji, ziarno i serie (podsumowanie + wszystkie pomiary)
+    void writeJson(std::ostream& out, const BuildInfo& build, unsigned seed, const std::string& timestamp) const {
+        out << "{\n  \"kompilacja\": {\"kompilator\": \"" << escapeJson(build.compiler)
+            << "\", \"standard\": \"" << escapeJson(build.standard)
+            << "\", \"optymalizacja\": \"" << escapeJson(build.optimization)
+            << "\", \"platforma\": \"" << escapeJson(build.platform) << "\"},\n"
+            << "  \"ziarno\": " << seed << ",\n"
+            << "  \"data\": \"" << escapeJson(timestamp) << "\",\n"
+            << "  \"serie\": [";
+        for (std::size_t i = 0; i < count; i++) {
+            const BenchmarkSeries& s = *series[i];
+            out << (i > 0 ? ",\n" : "\n") << "    {\"kolejka\": \"" << escapeJson(s.queue())
+                << "\", \"rozmiar\": " << s.size()
+                << ", \"operacja\": \"" << escapeJson(s.operation())
+                << "\", \"liczba\": " << s.sampleCount()
+                << ", \"srednia\": " << s.mean()
+                << ", \"mediana\": " << s.median()
+                << ", \"pomiary\": [";
+            for (std::size_t j = 0; j < s.sampleCount(); j++) {
+                out << (j > 0 ? ", " : "") << s.data()[j];
+            }
+            out << "]}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    //wczytanie CSV zapisanego przez writeCsv - false, gdy pliku nie ma albo format sie nie zgadza
+    bool loadCsv(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        if (!file.is_open() || !std::getline(file, line)) {
+            return false;
+        }
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+            line.erase(line.size() - 1);
+        }
+        if (line != csvHeader()) {
+            return false;
+        }
+
+        BenchmarkSeries* current = nullptr;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line[line.size() - 1] == '\r') {
+                line.erase(line.size() - 1);
+            }
+            if (line.empty()) {
+                continue;
+            }
+            std::istringstream row(line);
+            std::string queue, size, operation, index, value;
+            if (!std::getline(row, queue, ',') || !std::getline(row, size, ',') || !std::getline(row, operation, ',')
+                || !std::getline(row, index, ',') || !std::getline(row, value)) {
+                return false;
+            }
+            char* end = nullptr;
+            long sizeValue = std::strtol(size.c_str(), &end, 10);
+            if (end == size.c_str() || *end != '\0') {
+                return false;
+            }
+            double sample = std::strtod(value.c_str(), &end);
+            if (end == value.c_str() || *end != '\0') {
+                return false;
+            }
+            //wiersze jednej serii sa kolejno - wyszukiwanie tylko przy zmianie serii
+            if (current == nullptr || !current->matches(queue, (int)sizeValue, operation)) {
+                current = &get(queue, (int)sizeValue, operation);
+            }
+            current->record(sample);
+        }
+        return true;
+    }
+};
+
+//jednostronny test Manna-Whitneya: p-wartosc hipotezy, ze pomiary candidate sa stochastycznie
+//wieksze (wolniejsze) niz baseline; przyblizenie normalne z poprawka na remisy i ciaglosc
+//(przy kilkudziesieciu pomiarach na strone przyblizenie jest wystarczajace)
+inline double mannWhitneyGreaterPValue(const double* baseline, std::size_t n, const double* candidate, std::size_t m) {
+    if (n == 0 || m == 0) {
+        return 1.0;
+    }
+
+    struct Ranked {
+        double value;
+        bool fromCandidate;
+
+        bool operator<(const Ranked& other) const {
+            return value < other.value;
+        }
+    };
+
+    std::size_t total = n + m;
+    Ranked* all = new Ranked[total];
+    for (std::size_t i = 0; i < n; i++) {
+        all[i].value = baseline[i];
+        all[i].fromCandidate = false;
+    }
+    for (std::size_t i = 0; i < m; i++) {
+        all[n + i].value = candidate[i];
+        all[n + i].fromCandidate = true;
+    }
+    std::sort(all, all + total);
+
+    //suma rang kandydata (remisy dostaja range srednia) i poprawka wariancji na remisy
+    double candidateRankSum = 0;
+    double tieCorrection = 0;
+    std::size_t i = 0;
+    while (i < total) {
+        std::size_t j = i;
+        while (j + 1 < total && all[j + 1].value == all[i].value) {
+            j++;
+        }
+        double tied = (double)(j - i + 1);
+        double averageRank = (i + j) / 2.0 + 1.0;
+        for (std::size_t k = i; k <= j; k++) {
+            if (all[k].fromCandidate) {
+                candidateRankSum += averageRank;
+            }
+        }
+        tieCorrection += tied * tied * tied - tied;
+        i = j + 1;
+    }
+    delete[] all;
+
+    double nm = (double)n * (double)m;
+    double u = candidateRankSum - (double)m * (m + 1) / 2.0;
+    double variance = nm / 12.0 * ((total + 1) - tieCorrection / ((double)total * (total - 1)));
+    if (variance <= 0) {
+        return 1.0;     //wszystkie pomiary rowne - brak roznicy
+    }
+    double z = (u - nm / 2.0 - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+//porownanie przebiegow: raport na out (i wiersze CSV na csv) dla kazdej serii wystepujacej w obu
+//thresholdPercent i minimumDifference (ns) - minimalne pogorszenie mediany uznawane za regresje,
+//alpha - poziom istotnosci; zwraca liczbe regresji
+inline std::size_t compareBenchmarkResults(const BenchmarkResults& baseline, const BenchmarkResults& candidate,
+    double thresholdPercent, double minimumDifference, double alpha, std::ostream& out, std::ostream& csv) {
+    std::size_t regressions = 0;
+    std::size_t improvements = 0;
+    std::size_t compared = 0;
+
+    csv << "Kolejka,Rozmiar,Operacja,MedianaBazowa(ns),MedianaNowa(ns),Zmiana(%),p(wolniej),p(szybciej),Wynik" << "\n";
+    for (std::size_t s = 0; s < candidate.seriesCount(); s++) {
+        const BenchmarkSeries& next = candidate.at(s);
+        const BenchmarkSeries* base = baseline.find(next.queue(), next.size(), next.operation());
+        if (base == nullptr) {
+            out << "  (brak w wynikach bazowych) " << next.queue() << " " << next.size() << " " << next.operation() << "\n";
+            continue;
+        }
+        compared++;
+
+        double baseMedian = base->median();
+        double nextMedian = next.median();
+        double change = baseMedian > 0 ? (nextMedian - baseMedian) / baseMedian * 100.0 : 0.0;
+        double pSlower = mannWhitneyGreaterPValue(base->data(), base->sampleCount(), next.data(), next.sampleCount());
+        double pFaster = mannWhitneyGreaterPValue(next.data(), next.sampleCount(), base->data(), base->sampleCount());
+
+        const char* verdict = "bez zmian";
+        bool noticeable = std::fabs(nextMedian - baseMedian) > minimumDifference;
+        if (pSlower < alpha && change > thresholdPercent && noticeable) {
+            verdict = "REGRESJA";
+            regressions++;
+        }
+        else if (pFaster < alpha && change < -thresholdPercent && noticeable) {
+            verdict = "poprawa";
+            improvements++;
+        }
+
+        csv << next.queue() << "," << next.size() << "," << next.operation() << ","
+            << baseMedian << "," << nextMedian << "," << change << "," << pSlower << "," << pFaster << "," << verdict << "\n";
+        if (verdict[0] != 'b') {
+            out << "  " << verdict << ": " << next.queue() << ", rozmiar " << next.size() << ", " << next.operation()
+                << ": mediana " << baseMedian << " -> " << nextMedian << " ns (" << (change > 0 ? "+" : "") << change
+                << "%, p = " << (verdict[0] == 'R' ? pSlower : pFaster) << ")\n";
+        }
+    }
+    for (std::size_t s = 0; s < baseline.seriesCount(); s++) {
+        const BenchmarkSeries& base = baseline.at(s);
+        if (candidate.find(base.queue(), base.size(), base.operation()) == nullptr) {
+            out << "  (brak w nowych wynikach) " << base.queue() << " " << base.size() << " " << base.operation() << "\n";
+        }
+    }
+
+    out << "Porownane serie: " << compared << ", regresje: " << regressions << ", poprawy: " << improvements
+        << " (prog " << thresholdPercent << "% i " << minimumDifference << " ns, alfa " << alpha << ")\n";
+    return regressions;
+}
+
+#endif // BENCHMARK_COMPARISON_H
@@ -0,0 +1,366 @@
+#ifndef BLOCKED_HEAP_PRIORITY_QUEUE_H
+#define BLOCKED_HEAP_PRIORITY_QUEUE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "priority_order.h"
+#include "prefetch.h"
+
+//kolejka priorytetowa na kopcu w ukladzie blokowym (B-heap)
+//kazdy blok 2^BlockHeight miejsc przechowuje spojne poddrzewo o wysokosci BlockHeight
+//(2^BlockHeight - 1 wezlow, ostatnie miejsce bloku jest puste), a dzieci lisci bloku
+//sa korzeniami kolejnych blokow - schodzac w dol zmieniamy strone/linie pamieci co BlockHeight poziomow
+//bloki sa wypelniane po kolei, wiec tablica jest gesta i ostatni element zawsze jest lisciem
+//BlockHeight = 2 dla 16-bajtowych elementow to blok wielkosci linii cache (64 B), 8 to strona 4 KB
+template <typename T, typename Priority = int, typename Compare = std::less<Priority>,
+    typename Stability = StableOrder, unsigned BlockHeight = 8>
+class BlockedHeapPriorityQueue {
+    static_assert(BlockHeight >= 1 && BlockHeight < 16, "BlockHeight musi byc z zakresu 1..15");
+
+private:
+    typedef PriorityOrder<Priority, Compare> Order;
+    typedef PriorityEntry<T, Priority, Stability> HeapElement;
+
+    static const std::size_t BLOCK_SLOTS = (std::size_t)1 << BlockHeight;      //miejsca w bloku
+    static const std::size_t BLOCK_NODES = BLOCK_SLOTS - 1;                   //wezly w bloku
+    static const std::size_t FIRST_LEAF = ((std::size_t)1 << (BlockHeight - 1)) - 1;  //lokalny indeks pierwszego liscia
+    static const std::size_t ALIGNMENT = 64;                                  //wyrownanie blokow do linii cache
+
+    HeapElement* storage;  //zaalokowana tablica
+    HeapElement* heap;     //poczatek wyrownany do linii cache
+    std::size_t capacity;  //pojemnosc w miejscach (wielokrotnosc BLOCK_SLOTS)
+    std::size_t size;      //liczba elementow
+    InsertClock<Stability> insertCounter;  //licznik wstawien dla realizacji FIFO
+    Compare compare;
+
+    //czy element a ma byc obsluzony przed b (wyzszy priorytet, przy rownych wczesniejszy czas wstawienia)
+    bool precedes(const HeapElement& a, const HeapElement& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return HeapElement::before(a, b);
+    }
+
+    //miejsce w tablicy dla n-tego elementu (elementy zajmuja bloki po kolei)
+    static std::size_t slotOf(std::size_t n) {
+        return (n / BLOCK_NODES) * BLOCK_SLOTS + n % BLOCK_NODES;
+    }
+
+    static bool isPadding(std::size_t slot) {
+        return (slot & (BLOCK_SLOTS - 1)) == BLOCK_NODES;
+    }
+
+    //pierwsze dziecko (drugie jest zaraz za nim w tym samym bloku albo blok dalej)
+    static std::size_t firstChild(std::size_t slot) {
+        std::size_t local = slot & (BLOCK_SLOTS - 1);
+        if (local < FIRST_LEAF) {
+            return slot + local + 1;
+        }
+        std::size_t block = slot >> BlockHeight;
+        std::size_t childBlock = block * BLOCK_SLOTS + 1 + 2 * (local - FIRST_LEAF);
+        return childBlock * BLOCK_SLOTS;
+    }
+
+    static std::size_t secondChild(std::size_t slot, std::size_t first) {
+        return (slot & (BLOCK_SLOTS - 1)) < FIRST_LEAF ? first + 1 : first + BLOCK_SLOTS;
+    }
+
+    static std::size_t parentOf(std::size_t slot) {
+        std::size_t local = slot & (BLOCK_SLOTS - 1);
+        std::size_t block = slot >> BlockHeight;
+        if (local > 0) {
+            return block * BLOCK_SLOTS + (local - 1) / 2;
+        }
+        std::size_t parentBlock = (block - 1) >> BlockHeight;
+        std::size_t childIndex = (block - 1) & (BLOCK_SLOTS - 1);
+        return parentBlock * BLOCK_SLOTS + FIRST_LEAF + childIndex / 2;
+    }
+
+    static std::size_t roundToBlocks(std::size_t slots) {
+        if (slots < BLOCK_SLOTS) {
+            return BLOCK_SLOTS;
+        }
+        return (slots + BLOCK_SLOTS - 1) / BLOCK_SLOTS * BLOCK_SLOTS;
+    }
+
+    //przydzial tablicy z poczatkiem wyrownanym do ALIGNMENT (o ile rozmiar elementu na to pozwala)
+    void allocate(std::size_t slots, HeapElement*& newStorage, HeapElement*& newHeap) const {
+        std::size_t extra = ALIGNMENT / sizeof(HeapElement) + 1;
+        newStorage = new HeapElement[slots + extra];
+        newHeap = newStorage;
+        for (std::size_t i = 0; i < extra; i++) {
+            if ((std::uintptr_t)(newStorage + i) % ALIGNMENT == 0) {
+                newHeap = newStorage + i;
+                break;
+            }
+        }
+    }
+
+    //zmiana rozmiaru tablicy
+    void resize(std::size_t newCapacity) {
+        HeapElement* newStorage;
+        HeapElement* newHeap;
+        allocate(newCapacity, newStorage, newHeap);
+
+        std::size_t end = size == 0 ? 0 : slotOf(size - 1) + 1;
+        for (std::size_t i = 0; i < end; i++) {
+            newHeap[i] = heap[i];
+        }
+
+        delete[] storage;
+        storage = newStorage;
+        heap = newHeap;
+        capacity = newCapacity;
+    }
+
+    void copyFrom(const BlockedHeapPriorityQueue& other) {
+        allocate(capacity, storage, heap);
+        std::size_t end = size == 0 ? 0 : slotOf(size - 1) + 1;
+        for (std::size_t i = 0; i < end; i++) {
+            heap[i] = other.heap[i];
+        }
+    }
+
+    //przesiewanie w gore z dziura
+    void siftUp(std::size_t hole, HeapElement element) {
+        while (hole > 0) {
+            std::size_t parent = parentOf(hole);
+            if (!precedes(element, heap[parent])) {
+                break;
+            }
+            heap[hole] = std::move(heap[parent]);
+            hole = parent;
+        }
+        heap[hole] = std::move(element);
+    }
+
+    //przesiewanie w dol z dziura, end - pierwsze miejsce za ostatnim elementem
+    //pobieramy z wyprzedzeniem pierwsze wnuki (na granicy bloku lezace w nowych blokach)
+    void siftDown(std::size_t hole, HeapElement element, std::size_t end) {
+        std::size_t child = firstChild(hole);
+        while (child < end) {
+            std::size_t second = secondChild(hole, child);
+            std::size_t grandchild = firstChild(child);
+            if (grandchild < end) {
+                prefetchRead(&heap[grandchild]);
+                std::size_t secondGrandchild = second < end ? firstChild(second) : end;
+                if (secondGrandchild < end) {
+                    prefetchRead(&heap[secondGrandchild]);
+                }
+            }
+            if (second < end && precedes(heap[second], heap[child])) {
+                child = second;
+            }
+            if (!precedes(heap[child], element)) {
+                break;
+            }
+            heap[hole] = std::move(heap[child]);
+            hole = child;
+            child = firstChild(hole);
+        }
+        heap[hole] = std::move(element);
+    }
+
+    static const std::size_t notFound = (std::size_t)-1;   //wynik findElementIndex gdy brak elementu
+
+    std::size_t findElementIndex(const T& element) const {
+        std::size_t end = size == 0 ? 0 : slotOf(size - 1) + 1;
+        for (std::size_t i = 0; i < end; i++) {
+            if (!isPadding(i) && heap[i].value == element) {
+                return i;
+            }
+        }
+        return notFound;
+    }
+
+public:
+    //konstruktor
+    BlockedHeapPriorityQueue(std::size_t initialCapacity = 10, const Compare& comparator = Compare()) :
+        capacity(roundToBlocks(initialCapacity)), size(0), compare(comparator) {
+        allocate(capacity, storage, heap);
+    }
+
+    ~BlockedHeapPriorityQueue() {
+        delete[] storage;
+    }
+
+    BlockedHeapPriorityQueue(const BlockedHeapPriorityQueue& other) :
+        capacity(other.capacity), size(other.size), insertCounter(other.insertCounter), compare(other.compare) {
+        copyFrom(other);
+    }
+
+    BlockedHeapPriorityQueue& operator=(const BlockedHeapPriorityQueue& other) {
+        if (this != &other) {
+            delete[] storage;
+
+            capacity = other.capacity;
+            size = other.size;
+            insertCounter = other.insertCounter;
+            compare = other.compare;
+
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    //dodaj element i jego priorytet
+    void insert(const T& element, const Priority& priority) {
+        std::size_t slot = slotOf(size);
+        if (slot >= capacity) {
+            resize(capacity * 2);
+        }
+
+        siftUp(slot, HeapElement(priority, element, insertCounter.next()));
+        size++;
+    }
+
+    //usun element z najwiekszym priorytetem (dziura schodzi do liscia, potem ostatni element idzie w gore)
+    T extractMax() {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+
+        T maxElement = std::move(heap[0].value);
+        size--;
+
+        if (size > 0) {
+            std::size_t end = slotOf(size - 1) + 1;
+            HeapElement last = std::move(heap[slotOf(size)]);
+
+            std::size_t hole = 0;
+            std::size_t child = firstChild(0);
+            while (child < end) {
+                std::size_t second = secondChild(hole, child);
+                std::size_t grandchild = firstChild(child);
+                if (grandchild < end) {
+                    prefetchRead(&heap[grandchild]);
+                    std::size_t secondGrandchild = second < end ? firstChild(second) : end;
+                    if (secondGrandchild < end) {
+                        prefetchRead(&heap[secondGrandchild]);
+                    }
+                }
+                if (second < end && precedes(heap[second], heap[child])) {
+                    child = second;
+                }
+                heap[hole] = std::move(heap[child]);
+                hole = child;
+                child = firstChild(hole);
+            }
+            siftUp(hole, std::move(last));
+
+            //zmniejsz pojemnosc jesli jest duzo niewykorzystanego miejsca
+            if (end <= capacity / 4 && capacity / 2 >= BLOCK_SLOTS) {
+                resize(roundToBlocks(capacity / 2));
+            }
+        }
+
+        return maxElement;
+    }
+
+    T findMax() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return heap[0].value;
+    }
+
+    Priority getPriority(const T& element) const {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono elementu");
+        }
+        return heap[index].priority;
+    }
+
+    void modifyKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+
+        Priority oldPriority = heap[index].priority;
+        heap[index].priority = newPriority;
+
+        if (Order::higher(compare, newPriority, oldPriority)) {
+            siftUp(index, std::move(heap[index]));
+        }
+        else if (Order::higher(compare, oldPriority, newPriority)) {
+            siftDown(index, std::move(heap[index]), slotOf(size - 1) + 1);
+        }
+    }
+
+    void increaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+
+        if (!Order::higher(compare, newPriority, heap[index].priority)) {
+            throw std::runtime_error("Nowy priorytet musi byc wiekszy niz stary");
+        }
+
+        heap[index].priority = newPriority;
+        siftUp(index, std::move(heap[index]));
+    }
+
+    void decreaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+
+        if (!Order::higher(compare, heap[index].priority, newPriority)) {
+            throw std::runtime_error("Nowy priorytet musi byc mniejszy niz stary");
+        }
+
+        heap[index].priority = newPriority;
+        siftDown(index, std::move(heap[index]), slotOf(size - 1) + 1);
+    }
+
+    std::size_t returnSize() const {
+        return size;
+    }
+
+    std::size_t returnCapacity() const {
+        return capacity;
+    }
+
+    //pamiec zajmowana przez tablice (w bajtach, razem z miejscem na wyrownanie)
+    std::size_t memoryUsage() const {
+        return (capacity + ALIGNMENT / sizeof(HeapElement) + 1) * sizeof(HeapElement);
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    void clear() {
+        size = 0;
+        if (capacity > BLOCK_SLOTS) {
+            resize(BLOCK_SLOTS);
+        }
+    }
+
+    void print() const {
+        std::cout << "Kolejka Priorytetowa (Kopiec blokowy): " << std::endl;
+        std::size_t end = size == 0 ? 0 : slotOf(size - 1) + 1;
+        for (std::size_t i = 0; i < end; i++) {
+            if (isPadding(i)) {
+                continue;
+            }
+            std::cout << "Priorytet: " << heap[i].priority
+                << ", Element: " << heap[i].value;
+            heap[i].printInsertTime(std::cout);
+            std::cout << std::endl;
+        }
+    }
+};
+
+#endif // BLOCKED_HEAP_PRIORITY_QUEUE_H
@@ -0,0 +1,451 @@
+#ifndef DURABLE_PRIORITY_QUEUE_H
+#define DURABLE_PRIORITY_QUEUE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include "heap_priority_queue.h"
+#include "file_replace.h"
+
+//trwala kolejka priorytetowa: kolejka w pamieci + dziennik operacji (write-ahead log) na dysku
+//- kazda operacja zmieniajaca kolejke dopisuje zwarty rekord binarny (typ, wartosc, priorytet)
+//- rekordy sa zbierane w buforze i zapisywane grupowo (group commit): jeden fflush + fsync
+//  na groupCommitRecords rekordow; po awarii mozna stracic najwyzej ostatnia niezatwierdzona grupe,
+//  sync() wymusza zatwierdzenie od razu
+//- po compactionRecords rekordach dziennik jest kompaktowany: zawartosc kolejki trafia do pliku
+//  migawki (w kolejnosci priorytetow, wiec ponowne wstawienie odtwarza kolejnosc FIFO remisow),
+//  a dziennik zaczyna sie od nowa
+//- operacja trafia do pamieci i do bufora dziennika razem albo wcale: rekord jest dopisywany przed
+//  wykonaniem, a gdy wykonanie rzuci (brak elementu, pusta kolejka, brak pamieci), jest wycofywany;
+//  dopiero potem grupa jest zatwierdzana - wyjatek z zapisu, fsync albo kompaktowania oznacza, ze
+//  operacja jest wykonana w pamieci, ale nie jest jeszcze trwala; dziennik jest wtedy uznany za
+//  uszkodzony i nastepna operacja albo sync() zapisuje stan z pamieci od nowa (kompaktowanie)
+//- konstruktor odtwarza stan: wczytuje migawke i powtarza dziennik (niepelny ostatni rekord
+//  po awarii jest pomijany); migawka i dziennik maja numer generacji, wiec dziennik sprzed
+//  kompaktowania nie zostanie powtorzony drugi raz
+//Queue to HeapPriorityQueue albo ArrayPriorityQueue (potrzebna migawka snapshot() i remove)
+//T i Priority musza byc trywialnie kopiowalne; pliki nie sa przenosne miedzy architekturami
+template <typename T, typename Priority = int, typename Queue = HeapPriorityQueue<T, Priority> >
+class DurablePriorityQueue {
+private:
+    typedef typename Queue::Snapshot Snapshot;
+    typedef typename Snapshot::value_type Entry;
+
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_copyable<Priority>::value,
+        "DurablePriorityQueue wymaga trywialnie kopiowalnych typow");
+
+    enum RecordType {
+        RECORD_INSERT = 1,
+        RECORD_EXTRACT = 2,     //wartosc i priorytet usunietego elementu
+        RECORD_MODIFY = 3,
+        RECORD_CLEAR = 4,
+        RECORD_SHIFT = 5        //shiftAllPriorities - delta w polu priorytetu
+    };
+
+    static const std::size_t RECORD_SIZE = 1 + sizeof(T) + sizeof(Priority);
+    static const unsigned long long SNAPSHOT_MAGIC = 0x50514D4947415753ULL;  //"SWAGIMQP"
+    static const unsigned long long LOG_MAGIC = 0x50514C41574B4F4CULL;       //"LOKWALQP"
+
+    Queue queue;
+
+    std::string snapshotPath;
+    std::string logPath;
+    std::FILE* log;
+    unsigned long long generation;      //numer wspolny migawki i dziennika
+
+    char* pending;                      //niezatwierdzone rekordy
+    std::size_t pendingRecords;
+    std::size_t groupCommitRecords;
+
+    unsigned long long logRecords;      //rekordy w dzienniku od ostatniego kompaktowania
+    unsigned long long compactionRecords;
+
+    bool logDamaged;                    //zapis do dziennika sie nie powiodl - nastepny zapis to kompaktowanie
+
+    unsigned long long syncCount;
+    unsigned long long logBytes;        //bajty zapisane do dziennika (lacznie)
+    unsigned long long snapshotBytes;   //bajty zapisane do migawek (lacznie)
+
+    //fsync - dane musza byc na dysku, nie tylko w buforach systemu
+    static void syncFile(std::FILE* file) {
+        if (!syncToDisk(file)) {
+            throw std::runtime_error("Blad zapisu dziennika na dysk");
+        }
+    }
+
+    static void writeBytes(std::FILE* file, const void* data, std::size_t bytes) {
+        if (bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes) {
+            throw std::runtime_error("Blad zapisu pliku kolejki trwalej");
+        }
+    }
+
+    static bool readBytes(std::FILE* file, void* data, std::size_t bytes) {
+        return std::fread(data, 1, bytes, file) == bytes;
+    }
+
+    //rekord do bufora (przed wykonaniem operacji w pamieci)
+    void stageRecord(RecordType type, const T& value, const Priority& priority) {
+        if (logDamaged) {
+            compact();
+        }
+        char* record = pending + pendingRecords * RECORD_SIZE;
+        record[0] = (char)type;
+        std::memcpy(record + 1, &value, sizeof(T));
+        std::memcpy(record + 1 + sizeof(T), &priority, sizeof(Priority));
+        pendingRecords++;
+        logRecords++;
+    }
+
+    //zatwierdzenie po wykonaniu operacji: pelna grupa - sync, duzy dziennik - kompaktowanie
+    void commitRecords() {
+        if (pendingRecords == groupCommitRecords) {
+            sync();
+        }
+        if (logRecords >= compactionRecords) {
+            compact();
+        }
+    }
+
+    //rekord, wykonanie w pamieci i zatwierdzenie; rekord jest wycofywany, gdy wykonanie rzuci
+    template <typename Apply>
+    void logged(RecordType type, const T& value, const Priority& priority, Apply apply) {
+        stageRecord(type, value, priority);
+        try {
+            apply();
+        }
+        catch (...) {
+            pendingRecords--;
+            logRecords--;
+            throw;
+        }
+        commitRecords();
+    }
+
+    void openLog() {
+        log = std::fopen(logPath.c_str(), "wb");
+        if (log == nullptr) {
+            throw std::runtime_error("Nie mozna utworzyc pliku dziennika");
+        }
+        unsigned long long magic = LOG_MAGIC;
+        writeBytes(log, &magic, sizeof(magic));
+        writeBytes(log, &generation, sizeof(generation));
+        syncFile(log);
+        logBytes += sizeof(magic) + sizeof(generation);
+        logRecords = 0;
+    }
+
+    void loadSnapshot() {
+        std::FILE* file = std::fopen(snapshotPath.c_str(), "rb");
+        if (file == nullptr) {
+            return;     //brak migawki - pusta kolejka, generacja 0
+        }
+
+        unsigned long long magic = 0;
+        unsigned long long count = 0;
+        bool valid = readBytes(file, &magic, sizeof(magic)) && magic == SNAPSHOT_MAGIC &&
+            readBytes(file, &generation, sizeof(generation)) &&
+            readBytes(file, &count, sizeof(count));
+        for (unsigned long long i = 0; valid && i < count; i++) {
+            T value;
+            Priority priority;
+            valid = readBytes(file, &value, sizeof(T)) && readBytes(file, &priority, sizeof(Priority));
+            if (valid) {
+                queue.insert(value, priority);
+            }
+        }
+        std::fclose(file);
+
+        if (!valid) {
+            throw std::runtime_error("Uszkodzony plik migawki kolejki trwalej");
+        }
+    }
+
+    void replayLog() {
+        std::FILE* file = std::fopen(logPath.c_str(), "rb");
+        if (file == nullptr) {
+            return;
+        }
+
+        unsigned long long magic = 0;
+        unsigned long long logGeneration = 0;
+        if (!readBytes(file, &magic, sizeof(magic)) || magic != LOG_MAGIC ||
+            !readBytes(file, &logGeneration, sizeof(logGeneration)) || logGeneration != generation) {
+            //dziennik sprzed ostatniego kompaktowania (lub pusty po awarii) - juz zawarty w migawce
+            std::fclose(file);
+            return;
+        }
+
+        char record[RECORD_SIZE];
+        try {
+            while (readBytes(file, record, RECORD_SIZE)) {
+                T value;
+                Priority priority;
+                std::memcpy(&value, record + 1, sizeof(T));
+                std::memcpy(&priority, record + 1 + sizeof(T), sizeof(Priority));
+
+                switch (record[0]) {
+                case RECORD_INSERT:
+                    queue.insert(value, priority);
+                    break;
+                case RECORD_EXTRACT:
+                    //usuwany jest zapisany wpis (wartosc i priorytet), a nie biezacy maksymalny - remisy
+                    //utworzone przez modifyKey po kompaktowaniu moga sie rozstrzygac inaczej niz w kolejce
+                    //przed awaria (czasy wstawienia po wczytaniu migawki sa nadane od nowa, UnstableOrder
+                    //nie ma ich wcale); sam priorytet odroznia tez wpisy o powtarzajacej sie wartosci
+                    if (queue.isEmpty()) {
+                        throw std::runtime_error("Dziennik kolejki trwalej nie zgadza sie z migawka");
+                    }
+                    if (queue.findMax() == value && queue.findMaxPriority() == priority) {
+                        queue.extractMax();
+                    }
+                    else if (!queue.remove(value, priority)) {
+                        throw std::runtime_error("Dziennik kolejki trwalej nie zgadza sie z migawka");
+                    }
+                    break;
+                case RECORD_MODIFY:
+                    queue.modifyKey(value, priority);
+                    break;
+                case RECORD_CLEAR:
+                    queue.clear();
+                    break;
+                case RECORD_SHIFT:
+                    queue.shiftAllPriorities(priority);
+                    break;
+                default:
+                    throw std::runtime_error("Uszkodzony rekord dziennika kolejki trwalej");
+                }
+            }
+        }
+        catch (...) {
+            std::fclose(file);
+            throw;
+        }
+        std::fclose(file);
+    }
+
+public:
+    DurablePriorityQueue(const std::string& pathPrefix,
+        std::size_t groupCommit = 64,
+        unsigned long long compactionThreshold = 1000000) :
+        snapshotPath(pathPrefix + ".snap"), logPath(pathPrefix + ".wal"), log(nullptr), generation(0),
+        pendingRecords(0), groupCommitRecords(groupCommit > 0 ? groupCommit : 1),
+        logRecords(0), compactionRecords(compactionThreshold > 0 ? compactionThreshold : 1),
+        logDamaged(false), syncCount(0), logBytes(0), snapshotBytes(0) {
+        pending = new char[groupCommitRecords * RECORD_SIZE];
+        try {
+            loadSnapshot();
+            replayLog();
+            //odtworzony stan od razu trafia do nowej migawki (usuwa tez niepelny rekord z konca dziennika)
+            compact();
+        }
+        catch (...) {
+            if (log != nullptr) {
+                std::fclose(log);
+            }
+            delete[] pending;
+            throw;
+        }
+    }
+
+    ~DurablePriorityQueue() {
+        try {
+            sync();
+        }
+        catch (...) {
+            //destruktor nie moze rzucac - niezatwierdzona grupa przepada jak przy awarii
+        }
+        if (log != nullptr) {
+            std::fclose(log);
+        }
+        delete[] pending;
+    }
+
+    DurablePriorityQueue(const DurablePriorityQueue&) = delete;
+    DurablePriorityQueue& operator=(const DurablePriorityQueue&) = delete;
+
+    void insert(const T& element, const Priority& priority) {
+        logged(RECORD_INSERT, element, priority, [&]() { queue.insert(element, priority); });
+    }
+
+    T extractMax() {
+        T maxElement = queue.findMax();
+        Priority maxPriority = queue.findMaxPriority();
+        logged(RECORD_EXTRACT, maxElement, maxPriority, [&]() { queue.extractMax(); });
+        return maxElement;
+    }
+
+    T findMax() const {
+        return queue.findMax();
+    }
+
+    Priority findMaxPriority() const {
+        return queue.findMaxPriority();
+    }
+
+    Priority getPriority(const T& element) const {
+        return queue.getPriority(element);
+    }
+
+    void modifyKey(const T& element, const Priority& newPriority) {
+        logged(RECORD_MODIFY, element, newPriority, [&]() { queue.modifyKey(element, newPriority); });
+    }
+
+    //w dzienniku zapisywane jako modifyKey (kierunek zmiany jest juz sprawdzony)
+    void increaseKey(const T& element, const Priority& newPriority) {
+        logged(RECORD_MODIFY, element, newPriority, [&]() { queue.increaseKey(element, newPriority); });
+    }
+
+    void decreaseKey(const T& element, const Priority& newPriority) {
+        logged(RECORD_MODIFY, element, newPriority, [&]() { queue.decreaseKey(element, newPriority); });
+    }
+
+    void clear() {
+        logged(RECORD_CLEAR, T(), Priority(), [&]() { queue.clear(); });
+    }
+
+    //przesuniecie wszystkich priorytetow w O(1) - jeden rekord w dzienniku zamiast modifyKey na element
+    void shiftAllPriorities(const Priority& delta) {
+        logged(RECORD_SHIFT, T(), delta, [&]() { queue.shiftAllPriorities(delta); });
+    }
+
+    //tempo starzenia to ustawienie (jak groupCommit), nie stan - nie trafia do dziennika
+    void setAgingRate(const Priority& rate) {
+        queue.setAgingRate(rate);
+    }
+
+    //uplyw czasu zapisywany jako przesuniecie, wiec odtworzenie nie zalezy od tempa starzenia
+    void advanceAge(unsigned long long ticks = 1) {
+        shiftAllPriorities(queue.returnAgingRate() * static_cast<Priority>(ticks));
+    }
+
+    //zatwierdzenie zebranych rekordow: zapis + fsync
+    //po bledzie czesc grupy moze juz byc w pliku, wiec grupa nie jest zapisywana ponownie - dziennik
+    //zastepuje kompaktowanie ze stanu w pamieci (przy nastepnym sync albo operacji)
+    void sync() {
+        if (logDamaged) {
+            compact();
+            return;
+        }
+        if (pendingRecords == 0) {
+            return;
+        }
+        std::size_t bytes = pendingRecords * RECORD_SIZE;
+        try {
+            writeBytes(log, pending, bytes);
+            syncFile(log);
+        }
+        catch (...) {
+            logDamaged = true;
+            throw;
+        }
+        logBytes += bytes;
+        syncCount++;
+        pendingRecords = 0;
+    }
+
+    //zapis migawki w kolejnosci priorytetow i rozpoczecie nowego dziennika
+    //migawka powstaje w pliku tymczasowym i dopiero po fsync zastepuje poprzednia
+    //po uszkodzeniu dziennika niezatwierdzone rekordy nie sa zapisywane - sa juz w stanie w pamieci
+    void compact() {
+        if (log != nullptr && !logDamaged) {
+            sync();
+        }
+
+        Snapshot snapshot = queue.snapshot();
+        Entry* sorted = new Entry[snapshot.size() > 0 ? snapshot.size() : 1];
+        snapshot.copyTo(0, snapshot.size(), sorted);
+        std::sort(sorted, sorted + snapshot.size(), snapshot.precedesFn());
+
+        std::string temporaryPath = snapshotPath + ".tmp";
+        std::FILE* file = std::fopen(temporaryPath.c_str(), "wb");
+        if (file == nullptr) {
+            delete[] sorted;
+            throw std::runtime_error("Nie mozna utworzyc pliku migawki");
+        }
+
+        unsigned long long magic = SNAPSHOT_MAGIC;
+        unsigned long long nextGeneration = generation + 1;
+        unsigned long long count = snapshot.size();
+        try {
+            writeBytes(file, &magic, sizeof(magic));
+            writeBytes(file, &nextGeneration, sizeof(nextGeneration));
+            writeBytes(file, &count, sizeof(count));
+            for (std::size_t i = 0; i < snapshot.size(); i++) {
+                writeBytes(file, &sorted[i].value, sizeof(T));
+                Priority priority = snapshot.priorityOf(sorted[i]);
+                writeBytes(file, &priority, sizeof(Priority));
+            }
+            syncFile(file);
+        }
+        catch (...) {
+            std::fclose(file);
+            delete[] sorted;
+            throw;
+        }
+        std::fclose(file);
+        delete[] sorted;
+        snapshotBytes += 3 * sizeof(unsigned long long) + count * (sizeof(T) + sizeof(Priority));
+
+        //atomowa podmiana - po awarii zostaje stara albo nowa migawka (nigdy zadna)
+        if (!replaceFile(temporaryPath, snapshotPath)) {
+            throw std::runtime_error("Nie mozna zastapic pliku migawki");
+        }
+
+        generation = nextGeneration;
+        if (log != nullptr) {
+            std::fclose(log);
+            log = nullptr;
+        }
+        //nowa migawka zawiera wszystkie rekordy z bufora; bez dziennika kolejna operacja sprobuje ponownie
+        pendingRecords = 0;
+        logDamaged = true;
+        openLog();
+        logDamaged = false;
+    }
+
+    //kolejka w pamieci (tylko do odczytu)
+    const Queue& inMemory() const {
+        return queue;
+    }
+
+    std::size_t returnSize() const {
+        return queue.returnSize();
+    }
+
+    bool isEmpty() const {
+        return queue.isEmpty();
+    }
+
+    std::size_t memoryUsage() const {
+        return queue.memoryUsage() + groupCommitRecords * RECORD_SIZE;
+    }
+
+    unsigned long long returnSyncCount() const {
+        return syncCount;
+    }
+
+    unsigned long long returnLogBytes() const {
+        return logBytes;
+    }
+
+    unsigned long long returnSnapshotBytes() const {
+        return snapshotBytes;
+    }
+
+    unsigned long long returnGeneration() const {
+        return generation;
+    }
+
+    void print() const {
+        queue.print();
+        std::cout << "Dziennik: generacja " << generation << ", rekordow od kompaktowania " << logRecords
+            << ", niezatwierdzonych " << pendingRecords << std::endl;
+    }
+};
+
+#endif // DURABLE_PRIORITY_QUEUE_H
@@ -0,0 +1,164 @@
+#ifndef EVENT_SIMULATION_H
+#define EVENT_SIMULATION_H
+
+#include <stdexcept>
+#include <cstddef>
+#include <functional>
+
+//rdzen symulacji dyskretnej (lista zdarzen na kolejce priorytetowej)
+//petla: wyjecie najwczesniejszego zdarzenia, przesuniecie zegara na jego czas, obsluga przez model,
+//ktory planuje 0..k kolejnych zdarzen - kolejka pracuje w stanie ustalonym, jak w "hold model"
+
+typedef unsigned long long SimulationTime;
+
+//zdarzenie niesie swoj czas, wiec do petli wystarczy extractMax (nie kazda kolejka ma findMaxPriority)
+//id jest unikalny w ramach symulacji - pozwala uzyc kolejek wymagajacych roznych elementow (kolo czasowe)
+struct SimulationEvent {
+    SimulationTime time;
+    unsigned long long id;
+    int type;
+    int data;
+
+    bool operator==(const SimulationEvent& other) const {
+        return id == other.id;
+    }
+
+    bool operator!=(const SimulationEvent& other) const {
+        return id != other.id;
+    }
+};
+
+struct SimulationEventHash {
+    std::size_t operator()(const SimulationEvent& event) const {
+        return std::hash<unsigned long long>()(event.id);
+    }
+};
+
+//Queue - dowolna kolejka z insert(zdarzenie, czas) i extractMax zwracajaca najwczesniejszy czas, np.
+//HeapPriorityQueue<SimulationEvent, SimulationTime, std::greater<SimulationTime> > albo
+//TimingWheelPriorityQueue<SimulationEvent, SimulationEventHash> (terminy sa monotoniczne)
+//kolejka jest przekazywana z zewnatrz, bo kazda implementacja ma inny konstruktor
+//zdarzenia planowane w trakcie obslugi trafiaja do paczki i sa wstawiane razem przed kolejnym
+//wyjeciem (albo gdy paczka sie zapelni) - obsluga zdarzenia nie przeplata sie z praca kolejki
+template <typename Queue>
+class DiscreteEventSimulation {
+private:
+    Queue& queue;
+    SimulationEvent* batch;         //zdarzenia zaplanowane, jeszcze niewstawione do kolejki
+    std::size_t batchSize;
+    std::size_t batchCapacity;
+    SimulationTime now;
+    unsigned long long nextId;
+    unsigned long long processed;
+
+public:
+    DiscreteEventSimulation(Queue& eventQueue, std::size_t batchCapacityValue = 64) :
+        queue(eventQueue), batchSize(0), batchCapacity(batchCapacityValue > 0 ? batchCapacityValue : 1),
+        now(0), nextId(0), processed(0) {
+        batch = new SimulationEvent[batchCapacity];
+    }
+
+    ~DiscreteEventSimulation() {
+        delete[] batch;
+    }
+
+    DiscreteEventSimulation(const DiscreteEventSimulation&) = delete;
+    DiscreteEventSimulation& operator=(const DiscreteEventSimulation&) = delete;
+
+    //zaplanowanie zdarzenia na czas bezwzgledny (nie wczesniejszy niz biezacy) - zwraca jego id
+    unsigned long long scheduleAt(SimulationTime time, int type, int data = 0) {
+        if (time < now) {
+            throw std::runtime_error("Nie mozna zaplanowac zdarzenia w przeszlosci");
+        }
+        if (batchSize == batchCapacity) {
+            flush();
+        }
+        SimulationEvent& event = batch[batchSize++];
+        event.time = time;
+        event.id = nextId++;
+        event.type = type;
+        event.data = data;
+        return event.id;
+    }
+
+    //zaplanowanie zdarzenia za delay tickow od biezacego czasu
+    unsigned long long schedule(SimulationTime delay, int type, int data = 0) {
+        return scheduleAt(now + delay, type, data);
+    }
+
+    //zaplanowanie wielu zdarzen naraz (czasy bezwzgledne); id zdarzen sa nadawane tutaj
+    void scheduleBatch(const SimulationEvent* events, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            scheduleAt(events[i].time, events[i].type, events[i].data);
+        }
+    }
+
+    //wstawienie zaplanowanej paczki do kolejki
+    void flush() {
+        for (std::size_t i = 0; i < batchSize; i++) {
+            queue.insert(batch[i], batch[i].time);
+        }
+        batchSize = 0;
+    }
+
+    //obsluga jednego zdarzenia: model(zdarzenie, symulacja) - false gdy nie ma juz zdarzen
+    template <typename Model>
+    bool step(Model& model) {
+        flush();
+        if (queue.isEmpty()) {
+            return false;
+        }
+        SimulationEvent event = queue.extractMax();
+        now = event.time;
+        processed++;
+        model(event, *this);
+        return true;
+    }
+
+    //obsluga co najwyzej maxEvents zdarzen - zwraca liczbe obsluzonych
+    template <typename Model>
+    unsigned long long run(Model& model, unsigned long long maxEvents) {
+        unsigned long long count = 0;
+        while (count < maxEvents && step(model)) {
+            count++;
+        }
+        return count;
+    }
+
+    //obsluga wszystkich zdarzen o czasie nie pozniejszym niz endTime; zegar konczy na endTime
+    template <typename Model>
+    unsigned long long runUntil(Model& model, SimulationTime endTime) {
+        unsigned long long count = 0;
+        for (;;) {
+            flush();
+            if (queue.isEmpty() || queue.findMax().time > endTime) {
+                break;
+            }
+            step(model);
+            count++;
+        }
+        if (endTime > now) {
+            now = endTime;
+        }
+        return count;
+    }
+
+    SimulationTime currentTime() const {
+        return now;
+    }
+
+    unsigned long long returnProcessed() const {
+        return processed;
+    }
+
+    //zdarzenia oczekujace: w kolejce i w niewstawionej paczce
+    std::size_t returnPending() const {
+        return queue.returnSize() + batchSize;
+    }
+
+    std::size_t memoryUsage() const {
+        return queue.memoryUsage() + batchCapacity * sizeof(SimulationEvent);
+    }
+};
+
+#endif // EVENT_SIMULATION_H
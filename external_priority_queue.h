@@ -0,0 +1,464 @@
+#ifndef EXTERNAL_PRIORITY_QUEUE_H
+#define EXTERNAL_PRIORITY_QUEUE_H
+
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <type_traits>
+#include "priority_order.h"
+#include "heap_sift.h"
+
+//kolejka priorytetowa w pamieci zewnetrznej (sequence heap / buffer tree)
+//elementy trzymane sa w ograniczonym kopcu w RAM, a po jego zapelnieniu kopiec jest sortowany
+//i zapisywany duzymi sekwencyjnymi blokami jako posortowany przebieg (run) w pliku
+//z kazdego przebiegu w pamieci jest tylko jeden blok, a ich czola laczy maly kopiec scalajacy
+//przebiegi maja poziomy jak w sequence heap: nowy przebieg ma poziom 0, a gdy na poziomie zbierze sie
+//mergeFanIn przebiegow, sa scalane (k-way merge) w jeden przebieg poziomu wyzej - kazdy element jest
+//przepisywany O(log_k(n/M)) razy, a nie przy kazdym scalaniu jak przy laczeniu wszystkich przebiegow
+//budzet pamieci dzielony jest po polowie: kopiec wstawien i bufory odczytu przebiegow
+//brak modifyKey/getPriority - elementy na dysku nie sa adresowalne
+//T i Priority musza byc trywialnie kopiowalne (zapisywane binarnie)
+template <typename T, typename Priority = int, typename Compare = std::less<Priority>, typename Stability = StableOrder>
+class ExternalPriorityQueue {
+private:
+    typedef PriorityOrder<Priority, Compare> Order;
+    typedef PriorityEntry<T, Priority, Stability> Entry;
+
+    static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_copyable<Priority>::value,
+        "ExternalPriorityQueue wymaga trywialnie kopiowalnych typow");
+
+    //posortowany przebieg zapisany w pliku
+    struct Run {
+        std::string path;
+        std::ifstream file;
+        unsigned long long remaining;  //elementy jeszcze nieodczytane z pliku
+        Entry* buffer;                 //bufor odczytu (jeden blok)
+        std::size_t position;          //pozycja czola w buforze
+        std::size_t count;             //liczba elementow w buforze
+        unsigned level;                //0 - zrzut kopca wstawien, L + 1 - scalenie przebiegow poziomu L
+    };
+
+    //wezel kopca scalajacego - czolo przebiegu
+    struct MergeNode {
+        Entry entry;
+        std::size_t run;
+    };
+
+    struct EntryPrecedes {
+        const ExternalPriorityQueue* queue;
+
+        bool operator()(const Entry& a, const Entry& b) const {
+            return queue->precedes(a, b);
+        }
+    };
+
+    struct NodePrecedes {
+        const ExternalPriorityQueue* queue;
+
+        bool operator()(const MergeNode& a, const MergeNode& b) const {
+            return queue->precedes(a.entry, b.entry);
+        }
+    };
+
+    Entry* heap;                 //kopiec wstawien w pamieci
+    std::size_t heapCapacity;
+    std::size_t heapSize;
+
+    Run** runs;                  //przebiegi (nullptr - wolne miejsce po zakonczonym przebiegu)
+    std::size_t runSlots;        //liczba uzywanych miejsc w tablicy runs
+    std::size_t runCount;        //liczba aktywnych przebiegow
+    std::size_t maxRuns;         //ile buforow odczytu miesci sie w budzecie
+    std::size_t mergeFanIn;      //ile przebiegow jednego poziomu jest scalanych naraz
+    std::size_t blockEntries;    //rozmiar bloku I/O w elementach
+
+    MergeNode* mergeHeap;        //kopiec czol przebiegow
+    std::size_t mergeSize;
+
+    std::size_t size;
+    InsertClock<Stability> insertCounter;
+    Compare compare;
+
+    std::string filePrefix;
+    unsigned long long nextFileId;
+    unsigned long long bytesWritten;
+    unsigned long long bytesRead;
+    unsigned long long runsCreated;
+
+    bool precedes(const Entry& a, const Entry& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return Entry::before(a, b);
+    }
+
+    EntryPrecedes entryPrecedes() const {
+        EntryPrecedes fn = { this };
+        return fn;
+    }
+
+    NodePrecedes nodePrecedes() const {
+        NodePrecedes fn = { this };
+        return fn;
+    }
+
+    std::string nextPath() {
+        return filePrefix + "_" + std::to_string((unsigned long long)(std::uintptr_t)this)
+            + "_" + std::to_string(nextFileId++) + ".run";
+    }
+
+    //zapis tablicy posortowanych elementow duzymi blokami
+    void writeEntries(std::ofstream& out, const Entry* data, std::size_t count) {
+        std::size_t written = 0;
+        while (written < count) {
+            std::size_t chunk = std::min(blockEntries, count - written);
+            out.write((const char*)(data + written), chunk * sizeof(Entry));
+            written += chunk;
+        }
+        if (!out) {
+            throw std::runtime_error("Blad zapisu przebiegu na dysk");
+        }
+        bytesWritten += (unsigned long long)count * sizeof(Entry);
+    }
+
+    //wczytaj kolejny blok przebiegu; false gdy przebieg sie skonczyl
+    bool refill(Run& run) {
+        if (run.remaining == 0) {
+            return false;
+        }
+        std::size_t chunk = (std::size_t)std::min<unsigned long long>(blockEntries, run.remaining);
+        run.file.read((char*)run.buffer, chunk * sizeof(Entry));
+        if (!run.file) {
+            throw std::runtime_error("Blad odczytu przebiegu z dysku");
+        }
+        run.remaining -= chunk;
+        run.position = 0;
+        run.count = chunk;
+        bytesRead += (unsigned long long)chunk * sizeof(Entry);
+        return true;
+    }
+
+    //otworz przebieg zapisany w pliku i wstaw jego czolo do kopca scalajacego
+    void openRun(const std::string& path, unsigned long long count, unsigned level) {
+        Run* run = new Run();
+        run->path = path;
+        run->level = level;
+        run->remaining = count;
+        run->position = 0;
+        run->count = 0;
+        run->buffer = new Entry[blockEntries];
+        run->file.open(path.c_str(), std::ios::binary);
+        if (!run->file.is_open()) {
+            delete[] run->buffer;
+            delete run;
+            throw std::runtime_error("Nie mozna otworzyc pliku przebiegu");
+        }
+
+        std::size_t index = 0;
+        while (index < runSlots && runs[index] != nullptr) {
+            index++;
+        }
+        if (index == runSlots) {
+            runSlots++;
+        }
+        runs[index] = run;
+        runCount++;
+        refill(*run);
+
+        MergeNode node;
+        node.entry = run->buffer[0];
+        node.run = index;
+        siftUpHole(mergeHeap, mergeSize, node, nodePrecedes());
+        mergeSize++;
+    }
+
+    void closeRun(std::size_t index) {
+        Run* run = runs[index];
+        run->file.close();
+        std::remove(run->path.c_str());
+        delete[] run->buffer;
+        delete run;
+        runs[index] = nullptr;
+        runCount--;
+    }
+
+    //zdejmij czolo kopca czol (glownego albo tymczasowego przy scalaniu) i przesun dany przebieg
+    Entry popFront(MergeNode* fronts, std::size_t& frontCount) {
+        Entry top = fronts[0].entry;
+        std::size_t index = fronts[0].run;
+        Run& run = *runs[index];
+
+        run.position++;
+        if (run.position < run.count || refill(run)) {
+            MergeNode node;
+            node.entry = run.buffer[run.position];
+            node.run = index;
+            siftDownHole(fronts, frontCount, 0, node, nodePrecedes());
+        }
+        else {
+            popRootBottomUp(fronts, frontCount, nodePrecedes());
+            frontCount--;
+            closeRun(index);
+        }
+        return top;
+    }
+
+    Entry popMerge() {
+        return popFront(mergeHeap, mergeSize);
+    }
+
+    //zbudowanie kopca czol przebiegow o poziomie <= maxLevel, zwraca jego rozmiar
+    std::size_t collectFronts(MergeNode* fronts, unsigned maxLevel) const {
+        std::size_t frontCount = 0;
+        for (std::size_t i = 0; i < runSlots; i++) {
+            if (runs[i] != nullptr && runs[i]->level <= maxLevel) {
+                MergeNode node;
+                node.entry = runs[i]->buffer[runs[i]->position];
+                node.run = i;
+                siftUpHole(fronts, frontCount, node, nodePrecedes());
+                frontCount++;
+            }
+        }
+        return frontCount;
+    }
+
+    std::size_t runsAtLevel(unsigned level) const {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < runSlots; i++) {
+            if (runs[i] != nullptr && runs[i]->level == level) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    unsigned highestLevel() const {
+        unsigned level = 0;
+        for (std::size_t i = 0; i < runSlots; i++) {
+            if (runs[i] != nullptr && runs[i]->level > level) {
+                level = runs[i]->level;
+            }
+        }
+        return level;
+    }
+
+    //scal przebiegi o poziomie <= maxLevel w jeden przebieg poziomu maxLevel + 1
+    //(zwalnia ich bufory odczytu); kopiec glowny jest potem budowany od nowa z pozostalych czol
+    void mergeRuns(unsigned maxLevel) {
+        std::string path = nextPath();
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Nie mozna utworzyc pliku przebiegu");
+        }
+
+        MergeNode* fronts = new MergeNode[maxRuns + 1];
+        std::size_t frontCount = collectFronts(fronts, maxLevel);
+        Entry* output = new Entry[blockEntries];
+        std::size_t pending = 0;
+        unsigned long long total = 0;
+        try {
+            while (frontCount > 0) {
+                output[pending++] = popFront(fronts, frontCount);
+                if (pending == blockEntries) {
+                    writeEntries(out, output, pending);
+                    total += pending;
+                    pending = 0;
+                }
+            }
+            writeEntries(out, output, pending);
+            total += pending;
+        }
+        catch (...) {
+            delete[] fronts;
+            delete[] output;
+            throw;
+        }
+        delete[] fronts;
+        delete[] output;
+        out.close();
+
+        while (runSlots > 0 && runs[runSlots - 1] == nullptr) {
+            runSlots--;
+        }
+        mergeSize = collectFronts(mergeHeap, highestLevel());
+        openRun(path, total, maxLevel + 1);
+        runsCreated++;
+    }
+
+    //posortuj kopiec wstawien i zapisz go na dysk jako nowy przebieg
+    void spill() {
+        std::sort(heap, heap + heapSize, entryPrecedes());
+
+        std::string path = nextPath();
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Nie mozna utworzyc pliku przebiegu");
+        }
+        writeEntries(out, heap, heapSize);
+        out.close();
+
+        //kaskada: pelny poziom jest scalany w jeden przebieg poziomu wyzej (jak przeniesienie w liczniku)
+        unsigned level = 0;
+        while (runCount > 0 && runsAtLevel(level) >= mergeFanIn) {
+            mergeRuns(level);
+            level++;
+        }
+        //zabezpieczenie, gdy poziomow jest wiecej niz miesci budzet buforow - scalenie wszystkiego
+        if (runCount == maxRuns) {
+            mergeRuns(highestLevel());
+        }
+        openRun(path, heapSize, 0);
+        runsCreated++;
+        heapSize = 0;
+    }
+
+    //czy najlepszy element lezy w kopcu wstawien (a nie w przebiegach)
+    bool topInMemory() const {
+        if (mergeSize == 0) {
+            return true;
+        }
+        if (heapSize == 0) {
+            return false;
+        }
+        return precedes(heap[0], mergeHeap[0].entry);
+    }
+
+    void releaseRuns() {
+        for (std::size_t i = 0; i < runSlots; i++) {
+            if (runs[i] != nullptr) {
+                closeRun(i);
+            }
+        }
+        runSlots = 0;
+        mergeSize = 0;
+    }
+
+public:
+    //memoryBudget - przyblizony budzet pamieci w bajtach, blockBytes - rozmiar bloku I/O
+    //(najwyzej memoryBudget / 6, zeby kopiec i 3 bloki zmiescily sie w budzecie)
+    //filePrefix - sciezka i przedrostek plikow przebiegow
+    ExternalPriorityQueue(std::size_t memoryBudget = 64u << 20, std::size_t blockBytes = 1u << 20,
+        const std::string& prefix = "kolejka_zewnetrzna", const Compare& comparator = Compare()) :
+        heapSize(0), runSlots(0), runCount(0), mergeSize(0), size(0), compare(comparator), filePrefix(prefix),
+        nextFileId(0), bytesWritten(0), bytesRead(0), runsCreated(0) {
+        //druga polowa budzetu musi pomiescic co najmniej 2 bufory odczytu i bufor zapisu przy scalaniu -
+        //przy malym budzecie blok jest zmniejszany, zamiast przekraczac memoryBudget
+        std::size_t halfBudget = memoryBudget / 2;
+        if (halfBudget / 3 < sizeof(Entry)) {
+            throw std::runtime_error("Za maly budzet pamieci dla kolejki zewnetrznej");
+        }
+        blockEntries = std::min(blockBytes, halfBudget / 3) / sizeof(Entry);
+        blockEntries = std::max<std::size_t>(blockEntries, 1);
+        heapCapacity = halfBudget / sizeof(Entry);
+        //jeden blok rezerwujemy na bufor zapisu przy scalaniu
+        std::size_t readBudget = halfBudget - blockEntries * sizeof(Entry);
+        maxRuns = std::max<std::size_t>(readBudget / (blockEntries * sizeof(Entry)), 2);
+        //k ~ sqrt(maxRuns): miejsce na okolo sqrt(maxRuns) poziomow po k - 1 przebiegow
+        mergeFanIn = 2;
+        while ((mergeFanIn + 1) * (mergeFanIn + 1) <= maxRuns) {
+            mergeFanIn++;
+        }
+
+        heap = new Entry[heapCapacity];
+        runs = new Run*[maxRuns + 1];
+        mergeHeap = new MergeNode[maxRuns + 1];
+    }
+
+    ~ExternalPriorityQueue() {
+        releaseRuns();
+        delete[] heap;
+        delete[] runs;
+        delete[] mergeHeap;
+    }
+
+    ExternalPriorityQueue(const ExternalPriorityQueue&) = delete;
+    ExternalPriorityQueue& operator=(const ExternalPriorityQueue&) = delete;
+
+    //dodaj element i jego priorytet
+    void insert(const T& element, const Priority& priority) {
+        if (heapSize == heapCapacity) {
+            spill();
+        }
+        siftUpHole(heap, heapSize, Entry(priority, element, insertCounter.next()), entryPrecedes());
+        heapSize++;
+        size++;
+    }
+
+    //usun element z najwiekszym priorytetem
+    T extractMax() {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+
+        size--;
+        if (topInMemory()) {
+            T maxElement = heap[0].value;
+            popRootBottomUp(heap, heapSize, entryPrecedes());
+            heapSize--;
+            return maxElement;
+        }
+        return popMerge().value;
+    }
+
+    T findMax() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return topInMemory() ? heap[0].value : mergeHeap[0].entry.value;
+    }
+
+    //priorytet elementu z najwiekszym priorytetem
+    Priority findMaxPriority() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return topInMemory() ? heap[0].priority : mergeHeap[0].entry.priority;
+    }
+
+    std::size_t returnSize() const {
+        return size;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    //wyczysc kolejke i usun pliki przebiegow
+    void clear() {
+        releaseRuns();
+        heapSize = 0;
+        size = 0;
+    }
+
+    //pamiec zajmowana w RAM (w bajtach)
+    std::size_t memoryUsage() const {
+        return heapCapacity * sizeof(Entry) + runCount * blockEntries * sizeof(Entry)
+            + (maxRuns + 1) * (sizeof(Run*) + sizeof(MergeNode));
+    }
+
+    //liczba aktywnych przebiegow na dysku
+    std::size_t returnRunCount() const {
+        return runCount;
+    }
+
+    unsigned long long returnBytesWritten() const {
+        return bytesWritten;
+    }
+
+    unsigned long long returnBytesRead() const {
+        return bytesRead;
+    }
+
+    unsigned long long returnRunsCreated() const {
+        return runsCreated;
+    }
+};
+
+#endif // EXTERNAL_PRIORITY_QUEUE_H
@@ -0,0 +1,56 @@
+#ifndef FILE_REPLACE_H
+#define FILE_REPLACE_H
+
+#include <cstdio>
+#include <string>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//trwaly zapis plikow: dane na dysku (nie tylko w buforach systemu) i atomowa podmiana pliku
+//wzorzec: zapis do pliku tymczasowego, syncToDisk, replaceFile - po awarii na dysku jest
+//stary albo nowy plik, nigdy zaden
+
+//fflush + fsync - false, gdy zapis sie nie powiodl
+inline bool syncToDisk(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+//atomowa podmiana path plikiem temporaryPath (temporaryPath musi byc juz zsynchronizowany)
+//POSIX: rename zastepuje istniejacy plik atomowo, a fsync katalogu utrwala sama podmiane
+//Windows: rename nie nadpisuje istniejacego pliku - MoveFileEx z zastapieniem
+inline bool replaceFile(const std::string& temporaryPath, const std::string& path) {
+#ifdef _WIN32
+    return MoveFileExA(temporaryPath.c_str(), path.c_str(),
+        MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        return false;
+    }
+    std::string::size_type slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int descriptor = open(directory.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    bool synced = fsync(descriptor) == 0;
+    close(descriptor);
+    return synced;
+#endif
+}
+
+#endif // FILE_REPLACE_H
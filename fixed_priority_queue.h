@@ -0,0 +1,202 @@
+#ifndef FIXED_PRIORITY_QUEUE_H
+#define FIXED_PRIORITY_QUEUE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <array>
+#include <utility>
+#include "priority_order.h"
+#include "heap_sift.h"
+
+//kolejka priorytetowa na kopcu o stalej pojemnosci Capacity - tablica std::array wewnatrz obiektu,
+//bez zadnej alokacji na stercie (konstruktor, destruktor i kopia to tylko praca na tablicy)
+//insert przy pelnej kolejce rzuca wyjatek; kopia jest pelna kopia tablicy (O(Capacity))
+//metody (poza print) sa constexpr: od C++17 (constexpr operator[] std::array) kolejke mozna
+//wypelniac i oprozniac w wyrazeniach stalych dla literalnych T i Priority
+template <typename T, std::size_t Capacity, typename Priority = int, typename Compare = std::less<Priority>,
+    typename Stability = StableOrder>
+class FixedPriorityQueue {
+    static_assert(Capacity > 0, "Pojemnosc musi byc dodatnia");
+
+private:
+    typedef PriorityOrder<Priority, Compare> Order;
+    typedef PriorityEntry<T, Priority, Stability> HeapElement;
+
+    std::array<HeapElement, Capacity> heap;   //tablica kopca wewnatrz obiektu
+    std::size_t size;
+    InsertClock<Stability> insertCounter;
+    Compare compare;
+
+    constexpr bool precedes(const HeapElement& a, const HeapElement& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return HeapElement::before(a, b);
+    }
+
+    struct Precedes {
+        const FixedPriorityQueue* queue;
+
+        constexpr bool operator()(const HeapElement& a, const HeapElement& b) const {
+            return queue->precedes(a, b);
+        }
+    };
+
+    constexpr Precedes precedesFn() const {
+        return Precedes{ this };
+    }
+
+    //bez prefetch - cala tablica to kilka linii cache
+    constexpr void heapifyUp(std::size_t index) {
+        siftUpHole(heap.data(), index, std::move(heap[index]), precedesFn());
+    }
+
+    constexpr void heapifyDown(std::size_t index) {
+        siftDownHole<false>(heap.data(), size, index, std::move(heap[index]), precedesFn());
+    }
+
+    static const std::size_t notFound = (std::size_t)-1;
+
+    constexpr std::size_t findElementIndex(const T& element) const {
+        for (std::size_t i = 0; i < size; i++) {
+            if (heap[i].value == element) {
+                return i;
+            }
+        }
+        return notFound;
+    }
+
+public:
+    constexpr FixedPriorityQueue(const Compare& comparator = Compare()) :
+        heap(), size(0), insertCounter(), compare(comparator) {}
+
+    //kopia kolejki zawsze ma wlasna tablice - nie ma czego odlaczac (zgodnosc z pozostalymi kolejkami)
+    constexpr void detach() {}
+
+    constexpr bool isShared() const {
+        return false;
+    }
+
+    constexpr void insert(const T& element, const Priority& priority) {
+        if (size == Capacity) {
+            throw std::runtime_error("Kolejka jest pelna");
+        }
+        heap[size] = HeapElement(priority, element, insertCounter.next());
+        heapifyUp(size);
+        size++;
+    }
+
+    constexpr T extractMax() {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        T maxElement = std::move(heap[0].value);
+        popRootBottomUp<false>(heap.data(), size, precedesFn());
+        size--;
+        return maxElement;
+    }
+
+    constexpr T findMax() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return heap[0].value;
+    }
+
+    constexpr Priority findMaxPriority() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return heap[0].priority;
+    }
+
+    constexpr Priority getPriority(const T& element) const {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono elementu");
+        }
+        return heap[index].priority;
+    }
+
+    constexpr void modifyKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+
+        Priority oldPriority = heap[index].priority;
+        heap[index].priority = newPriority;
+        if (Order::higher(compare, newPriority, oldPriority)) {
+            heapifyUp(index);
+        }
+        else if (Order::higher(compare, oldPriority, newPriority)) {
+            heapifyDown(index);
+        }
+    }
+
+    constexpr void increaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+        if (!Order::higher(compare, newPriority, heap[index].priority)) {
+            throw std::runtime_error("Nowy priorytet musi byc wiekszy niz stary");
+        }
+        heap[index].priority = newPriority;
+        heapifyUp(index);
+    }
+
+    constexpr void decreaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+        if (!Order::higher(compare, heap[index].priority, newPriority)) {
+            throw std::runtime_error("Nowy priorytet musi byc mniejszy niz stary");
+        }
+        heap[index].priority = newPriority;
+        heapifyDown(index);
+    }
+
+    constexpr std::size_t returnSize() const {
+        return size;
+    }
+
+    constexpr std::size_t returnCapacity() const {
+        return Capacity;
+    }
+
+    //pamiec tablicy wewnatrz obiektu (na stercie - zero)
+    constexpr std::size_t memoryUsage() const {
+        return sizeof(heap);
+    }
+
+    constexpr bool isEmpty() const {
+        return size == 0;
+    }
+
+    constexpr bool isFull() const {
+        return size == Capacity;
+    }
+
+    constexpr void clear() {
+        size = 0;
+    }
+
+    void print() const {
+        std::cout << "Kolejka Priorytetowa (Kopiec o stalej pojemnosci " << Capacity << "): " << std::endl;
+        for (std::size_t i = 0; i < size; i++) {
+            std::cout << "Priorytet: " << heap[i].priority
+                << ", Element: " << heap[i].value;
+            heap[i].printInsertTime(std::cout);
+            std::cout << std::endl;
+        }
+    }
+};
+
+#endif // FIXED_PRIORITY_QUEUE_H
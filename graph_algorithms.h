@@ -0,0 +1,390 @@
+#ifndef GRAPH_ALGORITHMS_H
+#define GRAPH_ALGORITHMS_H
+
+#include <stdexcept>
+#include <cstddef>
+#include <cmath>
+#include <random>
+
+//algorytmy grafowe na kolejkach priorytetowych (Dijkstra, Prim, A*) i generatory grafow testowych
+//kolejka jest kolejka minimum: element to wierzcholek (int), priorytet to odleglosc/klucz
+//(GraphDistance z std::greater), np. HeapPriorityQueue<int, GraphDistance, std::greater<GraphDistance> >
+
+typedef unsigned long long GraphDistance;
+
+//graf nieskierowany w ukladzie CSR (sasiedzi wierzcholka v to targets[offsets[v]..offsets[v + 1]))
+//wierzcholki maja wspolrzedne na plaszczyznie, a waga krawedzi jest nie mniejsza niz ich odleglosc,
+//wiec podloga odleglosci euklidesowej jest spojna heurystyka dla A*
+class Graph {
+private:
+    std::size_t vertices;
+    std::size_t edges;           //liczba krawedzi nieskierowanych
+    std::size_t* offsets;
+    int* targets;
+    unsigned* weights;
+    double* xs;
+    double* ys;
+
+    void release() {
+        delete[] offsets;
+        delete[] targets;
+        delete[] weights;
+        delete[] xs;
+        delete[] ys;
+    }
+
+public:
+    Graph() : vertices(0), edges(0), offsets(new std::size_t[1]), targets(nullptr), weights(nullptr),
+        xs(nullptr), ys(nullptr) {
+        offsets[0] = 0;
+    }
+
+    ~Graph() {
+        release();
+    }
+
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+
+    //zbudowanie grafu z listy krawedzi (from[i], to[i]) - wagi: ceil(odleglosc) + extra[i]
+    void assign(std::size_t vertexCount, const double* x, const double* y,
+        const int* from, const int* to, const unsigned* extra, std::size_t edgeCount) {
+        std::size_t* newOffsets = new std::size_t[vertexCount + 1];
+        for (std::size_t v = 0; v <= vertexCount; v++) {
+            newOffsets[v] = 0;
+        }
+        for (std::size_t e = 0; e < edgeCount; e++) {
+            if (from[e] < 0 || to[e] < 0 || (std::size_t)from[e] >= vertexCount || (std::size_t)to[e] >= vertexCount) {
+                delete[] newOffsets;
+                throw std::runtime_error("Krawedz wskazuje na nieistniejacy wierzcholek");
+            }
+            newOffsets[from[e] + 1]++;
+            newOffsets[to[e] + 1]++;
+        }
+        for (std::size_t v = 0; v < vertexCount; v++) {
+            newOffsets[v + 1] += newOffsets[v];
+        }
+
+        release();
+        offsets = newOffsets;
+        targets = new int[2 * edgeCount];
+        weights = new unsigned[2 * edgeCount];
+        xs = new double[vertexCount];
+        ys = new double[vertexCount];
+        vertices = vertexCount;
+        edges = edgeCount;
+
+        std::size_t* fill = new std::size_t[vertexCount];
+        for (std::size_t v = 0; v < vertexCount; v++) {
+            xs[v] = x[v];
+            ys[v] = y[v];
+            fill[v] = offsets[v];
+        }
+        for (std::size_t e = 0; e < edgeCount; e++) {
+            double dx = x[from[e]] - x[to[e]];
+            double dy = y[from[e]] - y[to[e]];
+            unsigned weight = (unsigned)std::ceil(std::sqrt(dx * dx + dy * dy)) + extra[e];
+            targets[fill[from[e]]] = to[e];
+            weights[fill[from[e]]++] = weight;
+            targets[fill[to[e]]] = from[e];
+            weights[fill[to[e]]++] = weight;
+        }
+        delete[] fill;
+    }
+
+    std::size_t vertexCount() const {
+        return vertices;
+    }
+
+    std::size_t edgeCount() const {
+        return edges;
+    }
+
+    std::size_t firstEdge(int v) const {
+        return offsets[v];
+    }
+
+    std::size_t endEdge(int v) const {
+        return offsets[v + 1];
+    }
+
+    int target(std::size_t edge) const {
+        return targets[edge];
+    }
+
+    unsigned weight(std::size_t edge) const {
+        return weights[edge];
+    }
+
+    //spojna dolna granica odleglosci miedzy wierzcholkami (heurystyka A*)
+    GraphDistance lowerBound(int from, int to) const {
+        double dx = xs[from] - xs[to];
+        double dy = ys[from] - ys[to];
+        return (GraphDistance)std::floor(std::sqrt(dx * dx + dy * dy));
+    }
+};
+
+//krawedzie o losowym naddatku wagi 0..100 ponad odleglosc (odstep punktow siatki to 100)
+const unsigned GRAPH_EXTRA_WEIGHT = 100;
+
+//siatka side x side z krawedziami do 4 sasiadow
+inline void makeGridGraph(Graph& graph, int side, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<unsigned> extraWeight(0, GRAPH_EXTRA_WEIGHT);
+    std::size_t vertexCount = (std::size_t)side * side;
+    std::size_t edgeCount = side > 0 ? 2 * (std::size_t)side * (side - 1) : 0;
+    double* x = new double[vertexCount];
+    double* y = new double[vertexCount];
+    int* from = new int[edgeCount > 0 ? edgeCount : 1];
+    int* to = new int[edgeCount > 0 ? edgeCount : 1];
+    unsigned* extra = new unsigned[edgeCount > 0 ? edgeCount : 1];
+
+    std::size_t e = 0;
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            x[v] = 100.0 * c;
+            y[v] = 100.0 * r;
+            if (c + 1 < side) {
+                from[e] = v;
+                to[e] = v + 1;
+                extra[e++] = extraWeight(generator);
+            }
+            if (r + 1 < side) {
+                from[e] = v;
+                to[e] = v + side;
+                extra[e++] = extraWeight(generator);
+            }
+        }
+    }
+    graph.assign(vertexCount, x, y, from, to, extra, e);
+
+    delete[] x;
+    delete[] y;
+    delete[] from;
+    delete[] to;
+    delete[] extra;
+}
+
+//losowe punkty w kwadracie (srednio jeden na 100 x 100); sciezka 0-1-...-(n-1) zapewnia spojnosc,
+//pozostale krawedzie lacza losowe pary - srednio averageDegree sasiadow
+inline void makeRandomGraph(Graph& graph, int vertexCount, int averageDegree, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<unsigned> extraWeight(0, GRAPH_EXTRA_WEIGHT);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0 * std::sqrt((double)vertexCount));
+    std::uniform_int_distribution<int> vertex(0, vertexCount > 0 ? vertexCount - 1 : 0);
+    std::size_t edgeCount = vertexCount > 1 ? (std::size_t)vertexCount * averageDegree / 2 : 0;
+    if (vertexCount > 1 && edgeCount < (std::size_t)vertexCount - 1) {
+        edgeCount = vertexCount - 1;
+    }
+    double* x = new double[vertexCount > 0 ? vertexCount : 1];
+    double* y = new double[vertexCount > 0 ? vertexCount : 1];
+    int* from = new int[edgeCount > 0 ? edgeCount : 1];
+    int* to = new int[edgeCount > 0 ? edgeCount : 1];
+    unsigned* extra = new unsigned[edgeCount > 0 ? edgeCount : 1];
+
+    for (int v = 0; v < vertexCount; v++) {
+        x[v] = coordinate(generator);
+        y[v] = coordinate(generator);
+    }
+    std::size_t e = 0;
+    for (int v = 0; v + 1 < vertexCount; v++) {
+        from[e] = v;
+        to[e] = v + 1;
+        extra[e++] = extraWeight(generator);
+    }
+    while (e < edgeCount) {
+        from[e] = vertex(generator);
+        to[e] = vertex(generator);
+        if (from[e] != to[e]) {
+            extra[e++] = extraWeight(generator);
+        }
+    }
+    graph.assign(vertexCount, x, y, from, to, extra, e);
+
+    delete[] x;
+    delete[] y;
+    delete[] from;
+    delete[] to;
+    delete[] extra;
+}
+
+//graf bezskalowy (Barabasi-Albert): kazdy nowy wierzcholek laczy sie z edgesPerVertex
+//wierzcholkami wybranymi proporcjonalnie do stopnia (losowanie z listy koncow krawedzi)
+inline void makePowerLawGraph(Graph& graph, int vertexCount, int edgesPerVertex, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<unsigned> extraWeight(0, GRAPH_EXTRA_WEIGHT);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0 * std::sqrt((double)vertexCount));
+    std::size_t edgeCount = vertexCount > 1 ? (std::size_t)(vertexCount - 1) * edgesPerVertex : 0;
+    double* x = new double[vertexCount > 0 ? vertexCount : 1];
+    double* y = new double[vertexCount > 0 ? vertexCount : 1];
+    int* from = new int[edgeCount > 0 ? edgeCount : 1];
+    int* to = new int[edgeCount > 0 ? edgeCount : 1];
+    unsigned* extra = new unsigned[edgeCount > 0 ? edgeCount : 1];
+    int* endpoints = new int[2 * edgeCount > 0 ? 2 * edgeCount : 1];
+
+    for (int v = 0; v < vertexCount; v++) {
+        x[v] = coordinate(generator);
+        y[v] = coordinate(generator);
+    }
+    std::size_t e = 0;
+    for (int v = 1; v < vertexCount; v++) {
+        for (int k = 0; k < edgesPerVertex; k++) {
+            //pierwsza krawedz do losowego starszego wierzcholka (spojnosc), kolejne wg stopnia
+            int u;
+            if (k == 0 || e == 0) {
+                u = std::uniform_int_distribution<int>(0, v - 1)(generator);
+            }
+            else {
+                u = endpoints[std::uniform_int_distribution<std::size_t>(0, 2 * e - 1)(generator)];
+            }
+            from[e] = v;
+            to[e] = u;
+            extra[e] = extraWeight(generator);
+            endpoints[2 * e] = v;
+            endpoints[2 * e + 1] = u;
+            e++;
+        }
+    }
+    graph.assign(vertexCount, x, y, from, to, extra, e);
+
+    delete[] x;
+    delete[] y;
+    delete[] from;
+    delete[] to;
+    delete[] extra;
+    delete[] endpoints;
+}
+
+//liczniki operacji na kolejce w jednym przebiegu algorytmu
+struct GraphRunStats {
+    unsigned long long inserts;
+    unsigned long long extracts;
+    unsigned long long keyUpdates;   //poprawy klucza wierzcholka, ktory jest juz w kolejce
+    unsigned long long staleSkips;   //wyjete przestarzale wpisy (tylko strategia leniwa)
+    GraphDistance result;            //suma odleglosci / waga drzewa / dlugosc sciezki
+
+    unsigned long long operations() const {
+        return inserts + extracts + keyUpdates;
+    }
+};
+
+//strategia poprawy klucza: increaseKey (w kolejce minimum - zmniejszenie odleglosci),
+//kazdy wierzcholek jest w kolejce najwyzej raz
+struct DecreaseKeyUpdates {
+    template <typename Queue>
+    static void improve(Queue& queue, int vertex, GraphDistance key, bool queued, GraphRunStats& stats) {
+        if (queued) {
+            queue.increaseKey(vertex, key);
+            stats.keyUpdates++;
+        }
+        else {
+            queue.insert(vertex, key);
+            stats.inserts++;
+        }
+    }
+};
+
+//strategia leniwa: kazda poprawa to nowe wstawienie, a przestarzale wpisy sa pomijane przy wyjmowaniu
+//(dla kolejek bez increaseKey; poprawy nadal sa liczone jako keyUpdates)
+struct LazyUpdates {
+    template <typename Queue>
+    static void improve(Queue& queue, int vertex, GraphDistance key, bool queued, GraphRunStats& stats) {
+        queue.insert(vertex, key);
+        if (queued) {
+            stats.keyUpdates++;
+        }
+        else {
+            stats.inserts++;
+        }
+    }
+};
+
+const GraphDistance GRAPH_INFINITE_DISTANCE = ~(GraphDistance)0;
+
+//wspolny szkielet: A* z heurystyka zerowa to Dijkstra, a Prim roznicuje sie kluczem (waga krawedzi);
+//target < 0 - bez wczesnego zakonczenia
+template <typename Update, typename Queue>
+GraphRunStats searchGraph(const Graph& graph, int source, int target, bool prim, bool heuristic, Queue& queue) {
+    GraphRunStats stats = { 0, 0, 0, 0, 0 };
+    std::size_t n = graph.vertexCount();
+    if (source < 0 || (std::size_t)source >= n) {
+        throw std::runtime_error("Nieprawidlowy wierzcholek poczatkowy");
+    }
+    GraphDistance* key = new GraphDistance[n];       //najlepsza znana odleglosc (Prim: waga krawedzi)
+    unsigned char* state = new unsigned char[n];     //0 - nieodwiedzony, 1 - w kolejce, 2 - zamkniety
+    for (std::size_t v = 0; v < n; v++) {
+        key[v] = GRAPH_INFINITE_DISTANCE;
+        state[v] = 0;
+    }
+
+    try {
+        key[source] = 0;
+        state[source] = 1;
+        queue.insert(source, heuristic ? graph.lowerBound(source, target) : 0);
+        stats.inserts++;
+
+        while (!queue.isEmpty()) {
+            int u = queue.extractMax();
+            stats.extracts++;
+            if (state[u] == 2) {
+                stats.staleSkips++;
+                continue;
+            }
+            state[u] = 2;
+            stats.result += key[u];
+            if (u == target) {
+                stats.result = key[u];
+                break;
+            }
+
+            for (std::size_t e = graph.firstEdge(u); e < graph.endEdge(u); e++) {
+                int v = graph.target(e);
+                if (state[v] == 2) {
+                    continue;
+                }
+                GraphDistance candidate = prim ? graph.weight(e) : key[u] + graph.weight(e);
+                if (candidate < key[v]) {
+                    key[v] = candidate;
+                    GraphDistance priority = heuristic ? candidate + graph.lowerBound(v, target) : candidate;
+                    Update::improve(queue, v, priority, state[v] == 1, stats);
+                    state[v] = 1;
+                }
+            }
+        }
+        //A* konczy sie z otwartymi wierzcholkami, a strategia leniwa zostawia przestarzale wpisy
+        queue.clear();
+    }
+    catch (...) {
+        delete[] key;
+        delete[] state;
+        throw;
+    }
+    delete[] key;
+    delete[] state;
+    return stats;
+}
+
+//najkrotsze sciezki z source do wszystkich wierzcholkow - wynik to suma odleglosci osiagalnych
+template <typename Update, typename Queue>
+GraphRunStats runDijkstra(const Graph& graph, int source, Queue& queue) {
+    return searchGraph<Update>(graph, source, -1, false, false, queue);
+}
+
+//minimalne drzewo rozpinajace skladowej source - wynik to waga drzewa
+//klucze nie rosna monotonicznie, wiec kolejka musi dopuszczac wstawienia ponizej ostatniego wyjetego
+template <typename Update, typename Queue>
+GraphRunStats runPrim(const Graph& graph, int source, Queue& queue) {
+    return searchGraph<Update>(graph, source, -1, true, false, queue);
+}
+
+//najkrotsza sciezka source -> target z heurystyka odleglosci euklidesowej - wynik to jej dlugosc
+template <typename Update, typename Queue>
+GraphRunStats runAStar(const Graph& graph, int source, int target, Queue& queue) {
+    if (target < 0 || (std::size_t)target >= graph.vertexCount()) {
+        throw std::runtime_error("Nieprawidlowy wierzcholek docelowy");
+    }
+    return searchGraph<Update>(graph, source, target, false, true, queue);
+}
+
+#endif // GRAPH_ALGORITHMS_H
@@ -0,0 +1,93 @@
+#ifndef HEAP_SIFT_H
+#define HEAP_SIFT_H
+
+#include <cstddef>
+#include <utility>
+#include "prefetch.h"
+
+//silnik przesiewania kopca binarnego zapisanego w tablicy (dzieci i: 2i+1, 2i+2)
+//wszystkie funkcje sa iteracyjne i przesuwaja elementy do "dziury" zamiast je zamieniac
+//precedes(a, b) == true gdy a ma byc blizej korzenia niz b
+//funkcje sa constexpr (kolejki o stalej pojemnosci w wyrazeniach stalych); Prefetch = false wylacza
+//pobieranie z wyprzedzeniem - potrzebne w wyrazeniach stalych i zbedne dla malych tablic
+//touch(i) jest wolane przed kazda zmiana heap[i] (zapisem albo przeniesieniem z niego) - kolejka
+//z leniwa migawka (shared_buffer.h) zachowuje wtedy strone migawki; domyslnie NoTouch nic nie robi
+
+struct NoTouch {
+    constexpr void operator()(std::size_t) const {}
+};
+
+//przesiewanie w gore: rodzice sa przesuwani w dol, element trafia do koncowej dziury
+template <typename Entry, typename Precedes, typename Touch = NoTouch>
+constexpr void siftUpHole(Entry* heap, std::size_t hole, Entry element, const Precedes& precedes,
+    const Touch& touch = Touch()) {
+    touch(hole);
+    while (hole > 0) {
+        std::size_t parent = (hole - 1) / 2;
+        if (!precedes(element, heap[parent])) {
+            break;
+        }
+        touch(parent);
+        heap[hole] = std::move(heap[parent]);
+        hole = parent;
+    }
+    heap[hole] = std::move(element);
+}
+
+//przesiewanie w dol: lepsze dziecko jest przesuwane w gore dopoki wyprzedza element
+//wnuki (4 sasiednie elementy od 4i+3) sa pobierane z wyprzedzeniem
+template <bool Prefetch = true, typename Entry, typename Precedes, typename Touch = NoTouch>
+constexpr void siftDownHole(Entry* heap, std::size_t size, std::size_t hole, Entry element, const Precedes& precedes,
+    const Touch& touch = Touch()) {
+    touch(hole);
+    std::size_t child = 2 * hole + 1;
+    while (child < size) {
+        if (Prefetch && 2 * child + 1 < size) {
+            prefetchRead(&heap[2 * child + 1]);
+        }
+        if (child + 1 < size && precedes(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!precedes(heap[child], element)) {
+            break;
+        }
+        touch(child);
+        heap[hole] = std::move(heap[child]);
+        hole = child;
+        child = 2 * hole + 1;
+    }
+    heap[hole] = std::move(element);
+}
+
+//usuniecie korzenia metoda Floyda (bottom-up) - size to rozmiar przed usunieciem
+//dziura schodzi do liscia sciezka lepszych dzieci (jedno porownanie na poziom),
+//a ostatni element jest przesiewany w gore od tej dziury (zwykle o jeden, dwa poziomy)
+template <bool Prefetch = true, typename Entry, typename Precedes, typename Touch = NoTouch>
+constexpr void popRootBottomUp(Entry* heap, std::size_t size, const Precedes& precedes,
+    const Touch& touch = Touch()) {
+    std::size_t newSize = size - 1;
+    if (newSize == 0) {
+        return;
+    }
+
+    touch(0);
+    touch(newSize);
+    Entry last = std::move(heap[newSize]);
+    std::size_t hole = 0;
+    std::size_t child = 1;
+    while (child < newSize) {
+        if (Prefetch && 2 * child + 1 < newSize) {
+            prefetchRead(&heap[2 * child + 1]);
+        }
+        if (child + 1 < newSize && precedes(heap[child + 1], heap[child])) {
+            child++;
+        }
+        touch(child);
+        heap[hole] = std::move(heap[child]);
+        hole = child;
+        child = 2 * hole + 1;
+    }
+    siftUpHole(heap, hole, std::move(last), precedes, touch);
+}
+
+#endif // HEAP_SIFT_H
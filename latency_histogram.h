@@ -0,0 +1,201 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <ostream>
+#include <string>
+
+//histogram opoznien w skali log-liniowej (w stylu HDR)
+//wartosci ponizej SUB_BUCKETS sa zapisywane dokladnie, wyzej kazda potega dwojki
+//dzielona jest na SUB_BUCKETS/2 rownych kubelkow (blad wzgledny < 2^(1-PRECISION_BITS))
+class LatencyHistogram {
+private:
+    static const int PRECISION_BITS = 7;
+    static const unsigned long long SUB_BUCKETS = 1ULL << PRECISION_BITS;
+    static const unsigned long long HALF_BUCKETS = SUB_BUCKETS / 2;
+    //grupy 1..(64 - PRECISION_BITS + 1) pokrywaja caly zakres unsigned long long
+    static const int BUCKET_COUNT = (int)(SUB_BUCKETS + (64 - PRECISION_BITS + 1) * HALF_BUCKETS);
+
+    unsigned long long* counts;   //licznosci kubelkow
+    unsigned long long total;     //liczba zapisanych pomiarow
+    unsigned long long minValue;
+    unsigned long long maxValue;
+    double sum;                   //suma pomiarow (dla sredniej)
+
+    static int highestBit(unsigned long long value) {
+        int bit = 0;
+        while (value >>= 1) {
+            bit++;
+        }
+        return bit;
+    }
+
+    //indeks kubelka dla wartosci
+    static int bucketIndex(unsigned long long value) {
+        if (value < SUB_BUCKETS) {
+            return (int)value;
+        }
+        int group = highestBit(value) - PRECISION_BITS + 1;
+        return (int)(SUB_BUCKETS + (group - 1) * HALF_BUCKETS + ((value >> group) - HALF_BUCKETS));
+    }
+
+    //dolna granica kubelka (wlacznie)
+    static unsigned long long bucketLower(int index) {
+        if (index < (int)SUB_BUCKETS) {
+            return (unsigned long long)index;
+        }
+        unsigned long long k = index - SUB_BUCKETS;
+        int group = (int)(k / HALF_BUCKETS) + 1;
+        return (HALF_BUCKETS + k % HALF_BUCKETS) << group;
+    }
+
+    //gorna granica kubelka (wlacznie)
+    static unsigned long long bucketUpper(int index) {
+        if (index < (int)SUB_BUCKETS) {
+            return (unsigned long long)index;
+        }
+        int group = (int)((index - SUB_BUCKETS) / HALF_BUCKETS) + 1;
+        return bucketLower(index) + ((1ULL << group) - 1);
+    }
+
+public:
+    LatencyHistogram() : total(0), minValue(0), maxValue(0), sum(0) {
+        counts = new unsigned long long[BUCKET_COUNT];
+        reset();
+    }
+
+    ~LatencyHistogram() {
+        delete[] counts;
+    }
+
+    LatencyHistogram(const LatencyHistogram& other) :
+        total(other.total), minValue(other.minValue), maxValue(other.maxValue), sum(other.sum) {
+        counts = new unsigned long long[BUCKET_COUNT];
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            counts[i] = other.counts[i];
+        }
+    }
+
+    LatencyHistogram& operator=(const LatencyHistogram& other) {
+        if (this != &other) {
+            for (int i = 0; i < BUCKET_COUNT; i++) {
+                counts[i] = other.counts[i];
+            }
+            total = other.total;
+            minValue = other.minValue;
+            maxValue = other.maxValue;
+            sum = other.sum;
+        }
+        return *this;
+    }
+
+    //zapisz jeden pomiar (w nanosekundach)
+    void record(unsigned long long valueNs) {
+        counts[bucketIndex(valueNs)]++;
+        if (total == 0 || valueNs < minValue) {
+            minValue = valueNs;
+        }
+        if (total == 0 || valueNs > maxValue) {
+            maxValue = valueNs;
+        }
+        total++;
+        sum += (double)valueNs;
+    }
+
+    //wyczysc wszystkie pomiary
+    void reset() {
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            counts[i] = 0;
+        }
+        total = 0;
+        minValue = 0;
+        maxValue = 0;
+        sum = 0;
+    }
+
+    unsigned long long totalCount() const {
+        return total;
+    }
+
+    unsigned long long min() const {
+        return minValue;
+    }
+
+    unsigned long long max() const {
+        return maxValue;
+    }
+
+    double mean() const {
+        return total == 0 ? 0.0 : sum / (double)total;
+    }
+
+    //wartosc ponizej ktorej lezy podany procent pomiarow (gorna granica kubelka)
+    unsigned long long valueAtPercentile(double percentile) const {
+        if (total == 0) {
+            return 0;
+        }
+        double rank = percentile / 100.0 * (double)total;
+        unsigned long long target = (unsigned long long)rank;
+        if ((double)target < rank || target == 0) {
+            target++;
+        }
+        if (target > total) {
+            target = total;
+        }
+
+        unsigned long long cumulative = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            cumulative += counts[i];
+            if (cumulative >= target) {
+                unsigned long long upper = bucketUpper(i);
+                return upper < maxValue ? upper : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+    //zapisz niepuste kubelki jako wiersze CSV: prefiks,dolna,gorna,liczba,skumulowany procent
+    void writeCsvRows(std::ostream& out, const std::string& prefix) const {
+        unsigned long long cumulative = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            if (counts[i] == 0) {
+                continue;
+            }
+            cumulative += counts[i];
+            out << prefix << ","
+                << bucketLower(i) << ","
+                << bucketUpper(i) << ","
+                << counts[i] << ","
+                << (100.0 * (double)cumulative / (double)total) << "\n";
+        }
+    }
+
+    //zapisz histogram jako obiekt JSON (statystyki, percentyle i niepuste kubelki)
+    void writeJson(std::ostream& out) const {
+        out << "{\"count\": " << total
+            << ", \"min\": " << minValue
+            << ", \"mean\": " << mean()
+            << ", \"max\": " << maxValue
+            << ", \"percentiles\": {"
+            << "\"p50\": " << valueAtPercentile(50.0)
+            << ", \"p90\": " << valueAtPercentile(90.0)
+            << ", \"p99\": " << valueAtPercentile(99.0)
+            << ", \"p99.9\": " << valueAtPercentile(99.9)
+            << ", \"p99.99\": " << valueAtPercentile(99.99)
+            << "}, \"buckets\": [";
+
+        bool first = true;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            if (counts[i] == 0) {
+                continue;
+            }
+            if (!first) {
+                out << ", ";
+            }
+            out << "[" << bucketLower(i) << ", " << bucketUpper(i) << ", " << counts[i] << "]";
+            first = false;
+        }
+        out << "]}";
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
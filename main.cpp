@@ -5,8 +5,47 @@
 #include <fstream>
 #include <string>
 #include <limits>
+#include <sstream>
+#include <cstddef>
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <ctime>
+#include <cstdlib>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif !defined(__linux__)
+#include <sys/resource.h>
+#endif
 #include "heap_priority_queue.h"
 #include "array_priority_queue.h"
+#include "blocked_heap_priority_queue.h"
+#include "external_priority_queue.h"
+#include "sequence_heap.h"
+#include "timing_wheel.h"
+#include "durable_priority_queue.h"
+#include "async_checkpoint.h"
+#include "priority_task_scheduler.h"
+#include "latency_histogram.h"
+#include "event_simulation.h"
+#include "graph_algorithms.h"
+#include "fixed_priority_queue.h"
+#include "small_heap_priority_queue.h"
+#include "sorted_runs_priority_queue.h"
+#include "benchmark_comparison.h"
+
+// Liczba watkow dla budowy hurtowej, eksportu i zapisu w tle (opcja 9 w menu glownym)
+unsigned liczbaWatkow = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+
+// Ziarno danych testow wydajnosci - stale, aby przebiegi przed i po zmianie mierzyly to samo (--ziarno)
+unsigned ziarnoTestow = 12345;
 
 // Funkcja do generowania liczb losowych
 int generujLiczbeLosowaInt(int min, int max) {
@@ -25,41 +64,46 @@ bool wczytajZPliku(PQ& pq, const std::string& nazwaPliku) {
         return false;
     }
 
-    // Wyczyść istniejącą kolejkę przed wczytaniem nowych danych
-    while (!pq.isEmpty()) {
-        pq.extractMax();
-    }
+    // Wczytaj pary do tablic, a potem zbuduj kolejkę hurtowo (zastępuje zawartość, O(n), równolegle)
+    std::size_t pojemnosc = 1024;
+    std::size_t liczba = 0;
+    int* elementy = new int[pojemnosc];
+    int* priorytety = new int[pojemnosc];
 
     int element, priorytet;
     while (plik >> element >> priorytet) {
-        pq.insert(element, priorytet);
+        if (liczba == pojemnosc) {
+            int* noweElementy = new int[pojemnosc * 2];
+            int* nowePriorytety = new int[pojemnosc * 2];
+            std::copy(elementy, elementy + liczba, noweElementy);
+            std::copy(priorytety, priorytety + liczba, nowePriorytety);
+            delete[] elementy;
+            delete[] priorytety;
+            elementy = noweElementy;
+            priorytety = nowePriorytety;
+            pojemnosc *= 2;
+        }
+        elementy[liczba] = element;
+        priorytety[liczba] = priorytet;
+        liczba++;
     }
-
     plik.close();
+
+    pq.bulkLoad(elementy, priorytety, liczba, liczbaWatkow);
+
+    delete[] elementy;
+    delete[] priorytety;
     return true;
 }
 
 // Funkcja do zapisywania kolejki do pliku
 template <typename PQ>
 bool zapiszDoPliku(const PQ& pq, const std::string& nazwaPliku) {
-    std::ofstream plik(nazwaPliku);
-    if (!plik.is_open()) {
+    // Migawka (bez kopiowania tablicy) posortowana od najwyższego priorytetu - O(n log n)
+    if (!writeSnapshotFile(pq.snapshot(), nazwaPliku, liczbaWatkow)) {
         std::cerr << "Blad : Nie mozna otworzyc pliku " << nazwaPliku << " do zapisu" << std::endl;
         return false;
     }
-
-    // Tworzymy kopię kolejki, aby nie modyfikować oryginalnej
-    PQ kopiaPQ = pq;
-
-    // Zapisujemy elementy w kolejności od najwyższego priorytetu
-    while (!kopiaPQ.isEmpty()) {
-        int element = kopiaPQ.findMax();
-        int priorytet = kopiaPQ.getPriority(element);
-        plik << element << " " << priorytet << std::endl;
-        kopiaPQ.extractMax();
-    }
-
-    plik.close();
     return true;
 }
 
@@ -68,8 +112,13 @@ template <typename PQ>
 void wyswietlMenu(PQ& pq, const std::string& nazwaKolejki) {
     int wybor;
     bool dziala = true;
+    std::future<bool> zapisWTle;   // trwajacy zapis w tle (opcja 13)
 
     while (dziala) {
+        if (zapisWTle.valid() && zapisWTle.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            std::cout << (zapisWTle.get() ? "\nZapis w tle zakonczony." : "\nBlad: zapis w tle nie powiodl sie.") << std::endl;
+        }
+
         std::cout << "\n===== Menu " << nazwaKolejki << " =====" << std::endl;
         std::cout << "1. Dodaj element" << std::endl;
         std::cout << "2. Usun element o najwyzszym priorytecie" << std::endl;
@@ -83,7 +132,10 @@ void wyswietlMenu(PQ& pq, const std::string& nazwaKolejki) {
         std::cout << "10. Wczytaj z pliku" << std::endl;
         std::cout << "11. Zapisz do pliku" << std::endl;
         std::cout << "12. Wyczysc kolejkę" << std::endl;
-        std::cout << "13. Powrot " << std::endl;
+        std::cout << "13. Zapisz do pliku w tle" << std::endl;
+        std::cout << "14. Przesun priorytety wszystkich elementow" << std::endl;
+        std::cout << "15. Postarz elementy (starzenie priorytetow)" << std::endl;
+        std::cout << "16. Powrot " << std::endl;
         std::cout << "Wybierz opcje: ";
         std::cin >> wybor;
 
@@ -243,7 +295,7 @@ void wyswietlMenu(PQ& pq, const std::string& nazwaKolejki) {
         case 7: {
             // Pokaż rozmiar kolejki
             auto start = std::chrono::high_resolution_clock::now();
-            int rozmiar = pq.returnSize();
+            std::size_t rozmiar = pq.returnSize();
             auto end = std::chrono::high_resolution_clock::now();
 
             auto czas = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
@@ -334,7 +386,67 @@ void wyswietlMenu(PQ& pq, const std::string& nazwaKolejki) {
             std::cout << "Kolejka zostala wyczyszczona. Czas operacji: " << czas << " ns" << std::endl;
             break;
         }
-        case 13:
+        case 13: {
+            // Zapisz do pliku w tle - kolejka dziala dalej w trakcie zapisu
+            if (zapisWTle.valid()) {
+                std::cout << "Poprzedni zapis w tle jeszcze trwa." << std::endl;
+                break;
+            }
+
+            std::string nazwaPliku;
+            std::cout << "Podaj nazwe pliku do zapisu: ";
+            std::cin >> nazwaPliku;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            zapisWTle = saveAsync(pq, nazwaPliku, liczbaWatkow);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            auto czas = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            std::cout << "Rozpoczeto zapis w tle. Czas operacji: " << czas << " ns" << std::endl;
+            break;
+        }
+        case 14: {
+            // Przesun priorytety wszystkich elementow o te sama wartosc - O(1)
+            int przesuniecie;
+            std::cout << "Podaj przesuniecie priorytetow: ";
+            std::cin >> przesuniecie;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            pq.shiftAllPriorities(przesuniecie);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            auto czas = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            std::cout << "Priorytety przesuniete. Czas operacji: " << czas << " ns" << std::endl;
+            break;
+        }
+        case 15: {
+            // Starzenie - kazdy tick oczekiwania dodaje tempo do priorytetu elementow w kolejce
+            int tempo, ticki;
+            std::cout << "Podaj tempo starzenia (przyrost priorytetu na tick, aktualnie " << pq.returnAgingRate() << "): ";
+            std::cin >> tempo;
+            std::cout << "Podaj liczbe tickow: ";
+            std::cin >> ticki;
+            if (std::cin.fail() || ticki < 0) {
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::cout << "Nieprawidlowe dane." << std::endl;
+                break;
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            pq.setAgingRate(tempo);
+            pq.advanceAge(ticki);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            auto czas = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            std::cout << "Elementy postarzone (biezace przesuniecie " << pq.returnPriorityOffset()
+                << "). Czas operacji: " << czas << " ns" << std::endl;
+            break;
+        }
+        case 16:
+            if (zapisWTle.valid()) {
+                std::cout << (zapisWTle.get() ? "Zapis w tle zakonczony." : "Blad: zapis w tle nie powiodl sie.") << std::endl;
+            }
             dziala = false;
             break;
         default:
@@ -343,22 +455,92 @@ void wyswietlMenu(PQ& pq, const std::string& nazwaKolejki) {
     }
 }
 
-// Funkcja do utworzenia wypełnionej kolejki priorytetowej opartej na kopcu
-HeapPriorityQueue<int> utworzWypelnionaKolejkeKopca(int rozmiar, int powtorzenie, const int* losoweElementy, const int* losowePriorytety) {
-    HeapPriorityQueue<int> pq;
+// Funkcja do utworzenia wypełnionej kolejki z pomiarem czasu kazdego wstawienia (histogram moze byc nullptr)
+template <typename PQ>
+PQ utworzWypelnionaKolejke(int rozmiar, const int* losoweElementy, const int* losowePriorytety, LatencyHistogram* histogramWstawien) {
+    PQ pq;
     for (int i = 0; i < rozmiar; i++) {
+        if (histogramWstawien == nullptr) {
+            pq.insert(losoweElementy[i], losowePriorytety[i]);
+            continue;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
         pq.insert(losoweElementy[i], losowePriorytety[i]);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        histogramWstawien->record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
     }
     return pq;
 }
 
+// Funkcja do utworzenia wypełnionej kolejki priorytetowej opartej na kopcu
+HeapPriorityQueue<int> utworzWypelnionaKolejkeKopca(int rozmiar, int powtorzenie, const int* losoweElementy, const int* losowePriorytety, LatencyHistogram* histogramWstawien) {
+    return utworzWypelnionaKolejke<HeapPriorityQueue<int>>(rozmiar, losoweElementy, losowePriorytety, histogramWstawien);
+}
+
 // Funkcja do utworzenia wypełnionej kolejki priorytetowej opartej na tablicy
-ArrayPriorityQueue<int> utworzWypelnionaKolejkeTablicy(int rozmiar, int powtorzenie, const int* losoweElementy, const int* losowePriorytety) {
-    ArrayPriorityQueue<int> pq;
-    for (int i = 0; i < rozmiar; i++) {
-        pq.insert(losoweElementy[i], losowePriorytety[i]);
+ArrayPriorityQueue<int> utworzWypelnionaKolejkeTablicy(int rozmiar, int powtorzenie, const int* losoweElementy, const int* losowePriorytety, LatencyHistogram* histogramWstawien) {
+    return utworzWypelnionaKolejke<ArrayPriorityQueue<int>>(rozmiar, losoweElementy, losowePriorytety, histogramWstawien);
+}
+
+// Funkcja do utworzenia wypełnionej kolejki priorytetowej z posortowanymi przebiegami
+SortedRunsPriorityQueue<int> utworzWypelnionaKolejkePrzebiegow(int rozmiar, int /*powtorzenie*/, const int* losoweElementy, const int* losowePriorytety, LatencyHistogram* histogramWstawien) {
+    return utworzWypelnionaKolejke<SortedRunsPriorityQueue<int>>(rozmiar, losoweElementy, losowePriorytety, histogramWstawien);
+}
+
+// Pliki z pelnymi rozkladami opoznien operacji
+struct PlikiHistogramow {
+    std::ofstream percentyle;   // percentyle kazdej operacji (CSV)
+    std::ofstream kubelki;      // niepuste kubelki histogramow (CSV)
+    std::ofstream json;         // wszystko w jednym pliku JSON
+    bool pierwszyWpisJson;
+};
+
+// Funkcja otwierajaca pliki histogramow i zapisujaca naglowki
+bool otworzPlikiHistogramow(PlikiHistogramow& pliki) {
+    pliki.percentyle.open("percentyle_opoznien.csv");
+    pliki.kubelki.open("histogramy_opoznien.csv");
+    pliki.json.open("histogramy_opoznien.json");
+    if (!pliki.percentyle.is_open() || !pliki.kubelki.is_open() || !pliki.json.is_open()) {
+        return false;
     }
-    return pq;
+
+    pliki.percentyle << "Kolejka,Rozmiar,Operacja,Liczba,Min(ns),Srednia(ns),P50(ns),P90(ns),P99(ns),P99.9(ns),P99.99(ns),Max(ns)" << std::endl;
+    pliki.kubelki << "Kolejka,Rozmiar,Operacja,Od(ns),Do(ns),Liczba,Skumulowany(%)" << std::endl;
+    pliki.json << "[" << std::endl;
+    pliki.pierwszyWpisJson = true;
+    return true;
+}
+
+// Funkcja zapisujaca histogram jednej operacji do wszystkich plikow
+void zapiszHistogram(PlikiHistogramow& pliki, const std::string& nazwaKolejki, int rozmiar,
+    const std::string& operacja, const LatencyHistogram& histogram) {
+    if (histogram.totalCount() == 0) {
+        return;
+    }
+
+    pliki.percentyle << nazwaKolejki << "," << rozmiar << "," << operacja << ","
+        << histogram.totalCount() << ","
+        << histogram.min() << ","
+        << histogram.mean() << ","
+        << histogram.valueAtPercentile(50.0) << ","
+        << histogram.valueAtPercentile(90.0) << ","
+        << histogram.valueAtPercentile(99.0) << ","
+        << histogram.valueAtPercentile(99.9) << ","
+        << histogram.valueAtPercentile(99.99) << ","
+        << histogram.max() << std::endl;
+
+    histogram.writeCsvRows(pliki.kubelki, nazwaKolejki + "," + std::to_string(rozmiar) + "," + operacja);
+
+    if (!pliki.pierwszyWpisJson) {
+        pliki.json << "," << std::endl;
+    }
+    pliki.json << "  {\"kolejka\": \"" << nazwaKolejki << "\", \"rozmiar\": " << rozmiar
+        << ", \"operacja\": \"" << operacja << "\", \"histogram\": ";
+    histogram.writeJson(pliki.json);
+    pliki.json << "}";
+    pliki.pierwszyWpisJson = false;
 }
 
 // Funkcja do generowania losowych tablic do testów
@@ -383,6 +565,8 @@ void generujLosoweTablice(int** losoweElementy, int** losowePriorytety, int** lo
 // Szablon funkcji do testowania wydajności dowolnego typu kolejki priorytetowej
 template <typename PQ, typename FunkcjaUtworzWypelnionaKolejke>
 void testujWydajnoscKolejki(std::ofstream& plikWynikow,
+    PlikiHistogramow& plikiHistogramow,
+    BenchmarkResults& wynikiPomiarow,
     const std::string& nazwaKolejki,
     FunkcjaUtworzWypelnionaKolejke utworzWypelnionaKolejke,
     const int* losoweElementy,
@@ -397,7 +581,7 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
     plikWynikow << "\n=== " << nazwaKolejki << " ===" << std::endl;
 
     // Nagłówki CSV
-    plikWynikow << "Rozmiar,Insert(ns),ExtractMax(ns),FindMax(ns),ModifyKey(ns),ReturnSize(ns)" << std::endl;
+    plikWynikow << "Rozmiar,Insert(ns),ExtractMax(ns),FindMax(ns),ModifyKey(ns),ReturnSize(ns),Copy(ns),Detach(ns)" << std::endl;
 
     for (int r = 0; r < LICZBA_ROZMIAROW; r++) {
         int rozmiar = ROZMIARY_TESTOW[r];
@@ -409,14 +593,43 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
         double sumaFindMax = 0;
         double sumaModifyKey = 0;
         double sumaReturnSize = 0;
+        double sumaKopia = 0;
+        double sumaDetach = 0;
+
+        // Histogramy wszystkich pomiarow (srednie ukrywaja rzadkie skoki, np. resize)
+        LatencyHistogram histogramBudowy;
+        LatencyHistogram histogramInsert;
+        LatencyHistogram histogramExtractMax;
+        LatencyHistogram histogramFindMax;
+        LatencyHistogram histogramModifyKey;
+
+        // Wszystkie pojedyncze pomiary (do porownania przebiegow, --porownaj)
+        BenchmarkSeries& pomiaryInsert = wynikiPomiarow.get(nazwaKolejki, rozmiar, "Insert");
+        BenchmarkSeries& pomiaryExtractMax = wynikiPomiarow.get(nazwaKolejki, rozmiar, "ExtractMax");
+        BenchmarkSeries& pomiaryFindMax = wynikiPomiarow.get(nazwaKolejki, rozmiar, "FindMax");
+        BenchmarkSeries& pomiaryModifyKey = wynikiPomiarow.get(nazwaKolejki, rozmiar, "ModifyKey");
+        BenchmarkSeries& pomiaryReturnSize = wynikiPomiarow.get(nazwaKolejki, rozmiar, "ReturnSize");
+        BenchmarkSeries& pomiaryKopia = wynikiPomiarow.get(nazwaKolejki, rozmiar, "Copy");
+        BenchmarkSeries& pomiaryDetach = wynikiPomiarow.get(nazwaKolejki, rozmiar, "Detach");
 
         // Utwórz bazową kolejkę dla danego rozmiaru
-        PQ bazowaKolejka = utworzWypelnionaKolejke(rozmiar, 0, losoweElementy, losowePriorytety);
+        PQ bazowaKolejka = utworzWypelnionaKolejke(rozmiar, 0, losoweElementy, losowePriorytety, &histogramBudowy);
 
         for (int rep = 0; rep < POWTORZENIA; rep++) {
-            // Test operacji insert
+            // Test operacji insert (oraz kosztu kopii i jej odlaczenia od wspolnej tablicy)
             {
-                PQ kopiaKolejki = bazowaKolejka; // Kopia do testowania
+                auto startKopii = std::chrono::high_resolution_clock::now();
+                PQ kopiaKolejki = bazowaKolejka; // Kopia do testowania - wspoldzieli tablice (O(1))
+                auto endKopii = std::chrono::high_resolution_clock::now();
+                kopiaKolejki.detach(); // Wlasna tablica, aby pierwsza operacja nie placila za kopiowanie
+                auto endDetach = std::chrono::high_resolution_clock::now();
+                double czasKopii = std::chrono::duration<double, std::nano>(endKopii - startKopii).count();
+                double czasDetach = std::chrono::duration<double, std::nano>(endDetach - endKopii).count();
+                sumaKopia += czasKopii;
+                sumaDetach += czasDetach;
+                pomiaryKopia.record(czasKopii);
+                pomiaryDetach.record(czasDetach);
+
                 int element = rozmiar + rep; // Nowy element
                 int priorytet = losowePriorytety[rep % 100];
 
@@ -426,11 +639,14 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
 
                 std::chrono::duration<double, std::nano> czas = end - start;
                 sumaInsert += czas.count();
+                pomiaryInsert.record(czas.count());
+                histogramInsert.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
             }
 
             // Test operacji extract-max
             {
                 PQ kopiaKolejki = bazowaKolejka;
+                kopiaKolejki.detach();
                 if (!kopiaKolejki.isEmpty()) {
                     auto start = std::chrono::high_resolution_clock::now();
                     kopiaKolejki.extractMax();
@@ -438,6 +654,8 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
 
                     std::chrono::duration<double, std::nano> czas = end - start;
                     sumaExtractMax += czas.count();
+                    pomiaryExtractMax.record(czas.count());
+                    histogramExtractMax.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
                 }
             }
 
@@ -450,12 +668,15 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
 
                     std::chrono::duration<double, std::nano> czas = end - start;
                     sumaFindMax += czas.count();
+                    pomiaryFindMax.record(czas.count());
+                    histogramFindMax.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
                 }
             }
 
             // Test operacji modify-key
             {
                 PQ kopiaKolejki = bazowaKolejka;
+                kopiaKolejki.detach();
                 if (!kopiaKolejki.isEmpty()) {
                     int elementDoModyfikacji = losoweElementyDoModyfikacji[rep % 10] % rozmiar;
                     int nowyPriorytet = std::rand() % 1000000;
@@ -467,6 +688,8 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
 
                         std::chrono::duration<double, std::nano> czas = end - start;
                         sumaModifyKey += czas.count();
+                        pomiaryModifyKey.record(czas.count());
+                        histogramModifyKey.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
                     }
                     catch (...) {
                         // Ignoruj błędy (element może nie zostać znaleziony)
@@ -482,6 +705,7 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
 
                 std::chrono::duration<double, std::nano> czas = end - start;
                 sumaReturnSize += czas.count();
+                pomiaryReturnSize.record(czas.count());
             }
         }
 
@@ -491,6 +715,8 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
         double sredniaFindMax = sumaFindMax / POWTORZENIA;
         double sredniaModifyKey = sumaModifyKey / POWTORZENIA;
         double sredniaReturnSize = sumaReturnSize / POWTORZENIA;
+        double sredniaKopia = sumaKopia / POWTORZENIA;
+        double sredniaDetach = sumaDetach / POWTORZENIA;
 
         // Wyniki
         std::cout << "Rozmiar: " << rozmiar << std::endl;
@@ -499,6 +725,7 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
         std::cout << "  Find Max: " << sredniaFindMax << " ns" << std::endl;
         std::cout << "  Modify Key: " << sredniaModifyKey << " ns" << std::endl;
         std::cout << "  Return Size: " << sredniaReturnSize << " ns" << std::endl;
+        std::cout << "  Copy: " << sredniaKopia << " ns, Detach: " << sredniaDetach << " ns" << std::endl;
 
         // Zapisz do pliku
         plikWynikow << rozmiar << ","
@@ -506,14 +733,27 @@ void testujWydajnoscKolejki(std::ofstream& plikWynikow,
             << sredniaExtractMax << ","
             << sredniaFindMax << ","
             << sredniaModifyKey << ","
-            << sredniaReturnSize << std::endl;
+            << sredniaReturnSize << ","
+            << sredniaKopia << ","
+            << sredniaDetach << std::endl;
+
+        // Zapisz pelne rozklady opoznien
+        zapiszHistogram(plikiHistogramow, nazwaKolejki, rozmiar, "InsertBudowa", histogramBudowy);
+        zapiszHistogram(plikiHistogramow, nazwaKolejki, rozmiar, "Insert", histogramInsert);
+        zapiszHistogram(plikiHistogramow, nazwaKolejki, rozmiar, "ExtractMax", histogramExtractMax);
+        zapiszHistogram(plikiHistogramow, nazwaKolejki, rozmiar, "FindMax", histogramFindMax);
+        zapiszHistogram(plikiHistogramow, nazwaKolejki, rozmiar, "ModifyKey", histogramModifyKey);
+
+        std::cout << "  Insert p99: " << histogramInsert.valueAtPercentile(99.0) << " ns, max: " << histogramInsert.max() << " ns" << std::endl;
+        std::cout << "  Extract Max p99: " << histogramExtractMax.valueAtPercentile(99.0) << " ns, max: " << histogramExtractMax.max() << " ns" << std::endl;
     }
 }
 
 // Funkcja do uruchamiania testów wydajności
-void uruchomTestyWydajnosci() {
-    // Inicjalizacja generatora liczb losowych
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
+// oprócz raportu zapisuje wszystkie pomiary do nazwaWynikow.csv i nazwaWynikow.json (do --porownaj)
+bool uruchomTestyWydajnosci(unsigned ziarno, const std::string& nazwaWynikow) {
+    // Inicjalizacja generatora liczb losowych (to samo ziarno - te same dane testowe)
+    std::srand(ziarno);
 
     // Stałe dla testów
     const int POWTORZENIA = 100;
@@ -543,17 +783,33 @@ void uruchomTestyWydajnosci() {
         delete[] losowePriorytety;
         delete[] losoweElementyDoModyfikacji;
 
-        return;
+        return false;
     }
 
     // Zapisz nagłówek
     plikWynikow << "TESTY WYDAJNOSCI KOLEJEK PRIORYTETOWYCH" << std::endl;
 
+    // Otwórz pliki z rozkladami opoznien
+    PlikiHistogramow plikiHistogramow;
+    if (!otworzPlikiHistogramow(plikiHistogramow)) {
+        std::cerr << "Blad  Nie mozna otworzyc plikow histogramow." << std::endl;
+
+        delete[] losoweElementy;
+        delete[] losowePriorytety;
+        delete[] losoweElementyDoModyfikacji;
+
+        return false;
+    }
+
+    BenchmarkResults wynikiPomiarow;
+    bool sukces = true;
     try {
         // Uruchom testy dla każdego typu kolejki
         std::cout << "Testowanie kolejki priorytetowej opartej na kopcu..." << std::endl;
         testujWydajnoscKolejki<HeapPriorityQueue<int>>(
             plikWynikow,
+            plikiHistogramow,
+            wynikiPomiarow,
             "KOLEJKA PRIORYTETOWA OPARTA NA KOPCU",
             utworzWypelnionaKolejkeKopca,
             losoweElementy,
@@ -566,6 +822,8 @@ void uruchomTestyWydajnosci() {
         std::cout << "Testowanie kolejki priorytetowej opartej na tablicy..." << std::endl;
         testujWydajnoscKolejki<ArrayPriorityQueue<int>>(
             plikWynikow,
+            plikiHistogramow,
+            wynikiPomiarow,
             "KOLEJKA PRIORYTETOWA OPARTA NA TABLICY",
             utworzWypelnionaKolejkeTablicy,
             losoweElementy,
@@ -573,16 +831,50 @@ void uruchomTestyWydajnosci() {
             losoweElementyDoModyfikacji
         );
         plikWynikow.flush();
+
+        std::cout << "Testowanie kolejki priorytetowej z posortowanymi przebiegami..." << std::endl;
+        testujWydajnoscKolejki<SortedRunsPriorityQueue<int>>(
+            plikWynikow,
+            plikiHistogramow,
+            wynikiPomiarow,
+            "KOLEJKA PRIORYTETOWA Z POSORTOWANYMI PRZEBIEGAMI",
+            utworzWypelnionaKolejkePrzebiegow,
+            losoweElementy,
+            losowePriorytety,
+            losoweElementyDoModyfikacji
+        );
+        plikWynikow.flush();
     }
     catch (const std::exception& e) {
         std::cerr << "Wystapil blad podczas testowania: " << e.what() << std::endl;
+        sukces = false;
     }
     catch (...) {
         std::cerr << "Wystapil nieznany blad podczas testowania." << std::endl;
+        sukces = false;
     }
 
-    // Zamknij plik
+    // Zapisz wszystkie pomiary w formie do porownania (CSV bez sekcji, JSON z informacja o kompilacji)
+    std::time_t teraz = std::time(nullptr);
+    char data[32];
+    std::strftime(data, sizeof(data), "%Y-%m-%d %H:%M:%S", std::localtime(&teraz));
+    std::ofstream plikPomiarow(nazwaWynikow + ".csv");
+    std::ofstream plikJson(nazwaWynikow + ".json");
+    if (!plikPomiarow.is_open() || !plikJson.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc plikow " << nazwaWynikow << ".csv/.json" << std::endl;
+        sukces = false;
+    }
+    else {
+        wynikiPomiarow.writeCsv(plikPomiarow);
+        wynikiPomiarow.writeJson(plikJson, currentBuildInfo(), ziarno, data);
+    }
+
+    // Zamknij pliki
     plikWynikow.close();
+    plikiHistogramow.json << std::endl << "]" << std::endl;
+    plikiHistogramow.percentyle.close();
+    plikiHistogramow.kubelki.close();
+    plikiHistogramow.json.close();
 
     // Zwolnij zaalokowaną pamięć
     delete[] losoweElementy;
@@ -590,12 +882,1367 @@ void uruchomTestyWydajnosci() {
     delete[] losoweElementyDoModyfikacji;
 
     std::cout << "\nWyniki zostaly zapisane do pliku wyniki_kolejek_priorytetowych.csv" << std::endl;
+    std::cout << "Rozklady opoznien: percentyle_opoznien.csv, histogramy_opoznien.csv, histogramy_opoznien.json" << std::endl;
+    std::cout << "Wszystkie pomiary (ziarno " << ziarno << "): " << nazwaWynikow << ".csv, " << nazwaWynikow << ".json" << std::endl;
+    return sukces;
+}
+
+// Funkcja porownujaca dwa przebiegi testow wydajnosci (pliki CSV z uruchomTestyWydajnosci)
+// zwraca kod wyjscia: 0 - bez regresji, 1 - regresja, 2 - blad wczytania
+int porownajWyniki(const std::string& plikBazowy, const std::string& plikNowy, double prog, double progNs, double alfa) {
+    BenchmarkResults bazowe;
+    BenchmarkResults nowe;
+    if (!bazowe.loadCsv(plikBazowy)) {
+        std::cerr << "Blad : Nie mozna wczytac wynikow z pliku " << plikBazowy << std::endl;
+        return 2;
+    }
+    if (!nowe.loadCsv(plikNowy)) {
+        std::cerr << "Blad : Nie mozna wczytac wynikow z pliku " << plikNowy << std::endl;
+        return 2;
+    }
+
+    std::ofstream plikPorownania("porownanie_wydajnosci.csv");
+    if (!plikPorownania.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku porownania." << std::endl;
+        return 2;
+    }
+
+    std::cout << "POROWNANIE WYNIKOW: " << plikBazowy << " -> " << plikNowy << std::endl;
+    std::cout << "=====================================" << std::endl;
+    std::size_t regresje = compareBenchmarkResults(bazowe, nowe, prog, progNs, alfa, std::cout, plikPorownania);
+    plikPorownania.close();
+
+    std::cout << "\nWyniki zostaly zapisane do pliku porownanie_wydajnosci.csv" << std::endl;
+    return regresje > 0 ? 1 : 0;
+}
+
+// Funkcja odczytujaca szczytowa i biezaca pamiec rezydentna procesu (w bajtach, 0 gdy niedostepne)
+void pobierzPamiecProcesu(unsigned long long& szczytowa, unsigned long long& biezaca) {
+    szczytowa = 0;
+    biezaca = 0;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS liczniki;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &liczniki, sizeof(liczniki))) {
+        szczytowa = liczniki.PeakWorkingSetSize;
+        biezaca = liczniki.WorkingSetSize;
+    }
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string linia;
+    while (std::getline(status, linia)) {
+        std::istringstream wiersz(linia);
+        std::string klucz;
+        unsigned long long wartoscKB = 0;
+        wiersz >> klucz >> wartoscKB;
+        if (klucz == "VmHWM:") {
+            szczytowa = wartoscKB * 1024;
+        }
+        else if (klucz == "VmRSS:") {
+            biezaca = wartoscKB * 1024;
+        }
+    }
+#else
+    struct rusage uzycie;
+    if (getrusage(RUSAGE_SELF, &uzycie) == 0) {
+        szczytowa = (unsigned long long)uzycie.ru_maxrss;   // na macOS w bajtach
+        biezaca = szczytowa;
+    }
+#endif
+}
+
+// Funkcja zerujaca licznik szczytowej pamieci (tylko Linux), aby mierzyc kazdy rozmiar osobno
+void zresetujSzczytPamieci() {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs.is_open()) {
+        clearRefs << "5" << std::endl;
+    }
+#endif
+}
+
+// Szablon funkcji mierzacej przepustowosc i zuzycie pamieci kolejki dla duzych rozmiarow
+template <typename PQ>
+void testujSkalowalnoscKolejki(std::ofstream& plikWynikow,
+    const std::string& nazwaKolejki,
+    const unsigned long long* rozmiary,
+    int liczbaRozmiarow,
+    bool liniowyExtract) {
+    std::cout << "\n=== SKALOWALNOSC: " << nazwaKolejki << " ===" << std::endl;
+
+    for (int r = 0; r < liczbaRozmiarow; r++) {
+        unsigned long long rozmiar = rozmiary[r];
+        std::mt19937 generator(12345 + r);
+        std::uniform_int_distribution<int> rozkladPriorytetow(0, 1000000);
+
+        zresetujSzczytPamieci();
+
+        try {
+            PQ pq;
+
+            // Budowa kolejki - przepustowosc insert
+            auto start = std::chrono::high_resolution_clock::now();
+            for (unsigned long long i = 0; i < rozmiar; i++) {
+                pq.insert((int)i, rozkladPriorytetow(generator));
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double sekundyInsert = std::chrono::duration<double>(end - start).count();
+
+            std::size_t pojemnosc = pq.returnCapacity();
+            std::size_t pamiecKolejki = pq.memoryUsage();
+            double bajtyNaElement = (double)pamiecKolejki / (double)pq.returnSize();
+
+            // Liczba operacji extract-max ograniczona tak, aby O(n) skan nie trwal godzinami
+            unsigned long long liczbaExtract = liniowyExtract ? 1000000000ULL / rozmiar : 1000000ULL;
+            if (liczbaExtract < 1) {
+                liczbaExtract = 1;
+            }
+            if (liczbaExtract > rozmiar) {
+                liczbaExtract = rozmiar;
+            }
+
+            start = std::chrono::high_resolution_clock::now();
+            for (unsigned long long i = 0; i < liczbaExtract; i++) {
+                pq.extractMax();
+            }
+            end = std::chrono::high_resolution_clock::now();
+            double sekundyExtract = std::chrono::duration<double>(end - start).count();
+
+            unsigned long long szczytowaPamiec, biezacaPamiec;
+            pobierzPamiecProcesu(szczytowaPamiec, biezacaPamiec);
+
+            double insertNaSekunde = sekundyInsert > 0 ? rozmiar / sekundyInsert : 0;
+            double extractNaSekunde = sekundyExtract > 0 ? liczbaExtract / sekundyExtract : 0;
+
+            std::cout << "Rozmiar: " << rozmiar << std::endl;
+            std::cout << "  Insert: " << insertNaSekunde << " op/s" << std::endl;
+            std::cout << "  Extract Max: " << extractNaSekunde << " op/s (" << liczbaExtract << " operacji)" << std::endl;
+            std::cout << "  Pojemnosc: " << pojemnosc << ", pamiec: " << pamiecKolejki
+                << " B, bajtow na element: " << bajtyNaElement << std::endl;
+            std::cout << "  Szczytowy RSS: " << szczytowaPamiec << " B" << std::endl;
+
+            plikWynikow << nazwaKolejki << ","
+                << rozmiar << ","
+                << insertNaSekunde << ","
+                << extractNaSekunde << ","
+                << liczbaExtract << ","
+                << pojemnosc << ","
+                << pamiecKolejki << ","
+                << bajtyNaElement << ","
+                << szczytowaPamiec << ","
+                << biezacaPamiec << std::endl;
+        }
+        catch (const std::bad_alloc&) {
+            std::cerr << "Brak pamieci dla rozmiaru " << rozmiar << " - przerywam dla tej kolejki." << std::endl;
+            plikWynikow << nazwaKolejki << "," << rozmiar << ",brak pamieci" << std::endl;
+            return;
+        }
+    }
+}
+
+// Funkcja do uruchamiania testow skalowalnosci (rozmiary logarytmicznie do 10^8)
+void uruchomTestySkalowalnosci() {
+    unsigned long long maxRozmiar;
+    std::cout << "Podaj maksymalny rozmiar kolejki (np. 100000000): ";
+    std::cin >> maxRozmiar;
+    if (std::cin.fail() || maxRozmiar < 1000) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowy rozmiar (minimum 1000)." << std::endl;
+        return;
+    }
+
+    // Rozmiary 1-2-5 na kazda dekade od 10^3
+    const int MAX_LICZBA_ROZMIAROW = 64;
+    unsigned long long rozmiary[MAX_LICZBA_ROZMIAROW];
+    int liczbaRozmiarow = 0;
+    const unsigned long long MNOZNIKI[] = { 1, 2, 5 };
+    for (unsigned long long dekada = 1000; dekada <= maxRozmiar && liczbaRozmiarow < MAX_LICZBA_ROZMIAROW; dekada *= 10) {
+        for (int m = 0; m < 3; m++) {
+            if (dekada * MNOZNIKI[m] <= maxRozmiar && liczbaRozmiarow < MAX_LICZBA_ROZMIAROW) {
+                rozmiary[liczbaRozmiarow++] = dekada * MNOZNIKI[m];
+            }
+        }
+    }
+
+    std::ofstream plikWynikow("wyniki_skalowalnosci.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Kolejka,Rozmiar,Insert(op/s),ExtractMax(op/s),LiczbaExtract,Pojemnosc,PamiecKolejki(B),BajtyNaElement,SzczytowyRSS(B),BiezacyRSS(B)" << std::endl;
+
+    testujSkalowalnoscKolejki<HeapPriorityQueue<int>>(plikWynikow, "KOPIEC", rozmiary, liczbaRozmiarow, false);
+    plikWynikow.flush();
+    testujSkalowalnoscKolejki<HeapPriorityQueue<int, int, std::less<int>, UnstableOrder>>(plikWynikow, "KOPIEC NIESTABILNY", rozmiary, liczbaRozmiarow, false);
+    plikWynikow.flush();
+    testujSkalowalnoscKolejki<BlockedHeapPriorityQueue<int, int, std::less<int>, StableOrder, 2>>(plikWynikow, "KOPIEC BLOKOWY (LINIA CACHE)", rozmiary, liczbaRozmiarow, false);
+    plikWynikow.flush();
+    testujSkalowalnoscKolejki<BlockedHeapPriorityQueue<int, int, std::less<int>, StableOrder, 8>>(plikWynikow, "KOPIEC BLOKOWY (STRONA 4KB)", rozmiary, liczbaRozmiarow, false);
+    plikWynikow.flush();
+    testujSkalowalnoscKolejki<SequenceHeap<int>>(plikWynikow, "SEQUENCE HEAP", rozmiary, liczbaRozmiarow, false);
+    plikWynikow.flush();
+    testujSkalowalnoscKolejki<ArrayPriorityQueue<int>>(plikWynikow, "TABLICA", rozmiary, liczbaRozmiarow, true);
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_skalowalnosci.csv" << std::endl;
+}
+
+// Funkcja do testowania kolejki w pamieci zewnetrznej - wolumen I/O na operacje dla roznych budzetow pamieci
+void uruchomTestPamieciZewnetrznej() {
+    unsigned long long liczbaElementow;
+    std::cout << "Podaj liczbe elementow (np. 10000000): ";
+    std::cin >> liczbaElementow;
+    if (std::cin.fail() || liczbaElementow == 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba elementow." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_pamieci_zewnetrznej.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Elementy,Budzet(B),Faza,Czas(ns/op),Zapis(B/op),Odczyt(B/op),UtworzonePrzebiegi,PamiecRAM(B)" << std::endl;
+
+    const std::size_t BUDZETY[] = { 1u << 20, 8u << 20, 64u << 20 };
+    const int LICZBA_BUDZETOW = sizeof(BUDZETY) / sizeof(BUDZETY[0]);
+
+    for (int b = 0; b < LICZBA_BUDZETOW; b++) {
+        std::size_t budzet = BUDZETY[b];
+        std::cout << "\n=== PAMIEC ZEWNETRZNA: " << liczbaElementow << " elementow, budzet " << budzet << " B ===" << std::endl;
+
+        try {
+            ExternalPriorityQueue<int> pq(budzet, budzet / 64);
+            std::mt19937 generator(777);
+            std::uniform_int_distribution<int> rozkladPriorytetow(0, 1000000);
+
+            // Faza wstawiania
+            auto start = std::chrono::high_resolution_clock::now();
+            for (unsigned long long i = 0; i < liczbaElementow; i++) {
+                pq.insert((int)i, rozkladPriorytetow(generator));
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double nsInsert = std::chrono::duration<double, std::nano>(end - start).count() / liczbaElementow;
+            unsigned long long zapisInsert = pq.returnBytesWritten();
+            unsigned long long odczytInsert = pq.returnBytesRead();
+            std::size_t pamiec = pq.memoryUsage();
+
+            plikWynikow << liczbaElementow << "," << budzet << ",insert," << nsInsert << ","
+                << (double)zapisInsert / liczbaElementow << ","
+                << (double)odczytInsert / liczbaElementow << ","
+                << pq.returnRunsCreated() << "," << pamiec << std::endl;
+            std::cout << "  Insert: " << nsInsert << " ns/op, zapis " << (double)zapisInsert / liczbaElementow
+                << " B/op, odczyt " << (double)odczytInsert / liczbaElementow << " B/op" << std::endl;
+
+            // Faza usuwania
+            start = std::chrono::high_resolution_clock::now();
+            while (!pq.isEmpty()) {
+                pq.extractMax();
+            }
+            end = std::chrono::high_resolution_clock::now();
+            double nsExtract = std::chrono::duration<double, std::nano>(end - start).count() / liczbaElementow;
+            double zapisExtract = (double)(pq.returnBytesWritten() - zapisInsert) / liczbaElementow;
+            double odczytExtract = (double)(pq.returnBytesRead() - odczytInsert) / liczbaElementow;
+
+            plikWynikow << liczbaElementow << "," << budzet << ",extractMax," << nsExtract << ","
+                << zapisExtract << "," << odczytExtract << ","
+                << pq.returnRunsCreated() << "," << pamiec << std::endl;
+            std::cout << "  Extract Max: " << nsExtract << " ns/op, zapis " << zapisExtract
+                << " B/op, odczyt " << odczytExtract << " B/op" << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Blad: " << e.what() << std::endl;
+        }
+    }
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_pamieci_zewnetrznej.csv" << std::endl;
+}
+
+// Kolejki uzywane w tescie zegarow: kopiec terminow (najwczesniejszy termin = najwyzszy priorytet),
+// surowe kolo czasowe z tablica uchwytow oraz adapter kola z interfejsem kolejki
+typedef HeapPriorityQueue<int, unsigned long long, std::greater<unsigned long long> > KopiecTerminow;
+
+struct KoloZUchwytami {
+    TimingWheel<int> kolo;
+    TimingWheel<int>::Handle* uchwyty;     // uchwyt zegara o danym identyfikatorze
+
+    KoloZUchwytami(int liczbaIdentyfikatorow) : kolo(1024) {
+        uchwyty = new TimingWheel<int>::Handle[liczbaIdentyfikatorow];
+    }
+
+    ~KoloZUchwytami() {
+        delete[] uchwyty;
+    }
+
+    std::size_t memoryUsage() const {
+        return kolo.memoryUsage();
+    }
+};
+
+void zaplanujZegar(KopiecTerminow& kolejka, int id, unsigned long long termin) {
+    kolejka.insert(id, termin);
+}
+
+void zaplanujZegar(TimingWheelPriorityQueue<int>& kolejka, int id, unsigned long long termin) {
+    kolejka.insert(id, termin);
+}
+
+void zaplanujZegar(KoloZUchwytami& kolejka, int id, unsigned long long termin) {
+    kolejka.uchwyty[id] = kolejka.kolo.schedule(id, termin);
+}
+
+// Kopiec nie ma usuwania - anulowanie to przesuniecie na szczyt i extractMax (O(n) na wyszukanie)
+void anulujZegar(KopiecTerminow& kolejka, int id) {
+    kolejka.modifyKey(id, 0);
+    kolejka.extractMax();
+}
+
+void anulujZegar(TimingWheelPriorityQueue<int>& kolejka, int id) {
+    kolejka.remove(id);
+}
+
+void anulujZegar(KoloZUchwytami& kolejka, int id) {
+    kolejka.kolo.cancel(kolejka.uchwyty[id]);
+}
+
+int odbierzWygasle(KopiecTerminow& kolejka, unsigned long long czas, int* bufor, int maksimum) {
+    int liczba = 0;
+    while (liczba < maksimum && !kolejka.isEmpty() && kolejka.findMaxPriority() <= czas) {
+        bufor[liczba++] = kolejka.extractMax();
+    }
+    return liczba;
+}
+
+int odbierzWygasle(TimingWheelPriorityQueue<int>& kolejka, unsigned long long czas, int* bufor, int maksimum) {
+    return (int)kolejka.advanceTo(czas, bufor, maksimum);
+}
+
+int odbierzWygasle(KoloZUchwytami& kolejka, unsigned long long czas, int* bufor, int maksimum) {
+    return (int)kolejka.kolo.advanceTo(czas, bufor, maksimum);
+}
+
+// Jeden krok obciazenia zegarow - wspolny skrypt dla wszystkich kolejek
+struct KrokZegarow {
+    unsigned long long opoznienie;   // termin nowego zegara = czas + opoznienie
+    bool anuluj;                     // czy w tym kroku anulowac losowy aktywny zegar
+    unsigned int wybor;              // losowa liczba wybierajaca anulowany zegar
+};
+
+// Zbior aktywnych zegarow z usuwaniem w O(1) (zamiana z ostatnim)
+struct AktywneZegary {
+    int* zegary;
+    int* pozycje;
+    int liczba;
+
+    AktywneZegary(int liczbaIdentyfikatorow) : liczba(0) {
+        zegary = new int[liczbaIdentyfikatorow];
+        pozycje = new int[liczbaIdentyfikatorow];
+    }
+
+    ~AktywneZegary() {
+        delete[] zegary;
+        delete[] pozycje;
+    }
+
+    void dodaj(int id) {
+        pozycje[id] = liczba;
+        zegary[liczba++] = id;
+    }
+
+    void usun(int id) {
+        int pozycja = pozycje[id];
+        int ostatni = zegary[--liczba];
+        zegary[pozycja] = ostatni;
+        pozycje[ostatni] = pozycja;
+    }
+};
+
+// Szablon funkcji mierzacej obciazenie zegarow: w kazdym kroku czas rosnie o 1, planowany jest
+// nowy zegar, czesc aktywnych zegarow jest anulowana, a wygasle sa odbierane paczkami
+template <typename Kolejka>
+void testujObciazenieZegarow(std::ofstream& plikWynikow,
+    const std::string& nazwaKolejki,
+    Kolejka& kolejka,
+    int liczbaPoczatkowa,
+    const KrokZegarow* kroki,
+    int liczbaKrokow) {
+    const int ROZMIAR_PACZKI = 64;
+    int bufor[ROZMIAR_PACZKI];
+    AktywneZegary aktywne(liczbaPoczatkowa + liczbaKrokow);
+
+    // Wypelnienie poczatkowe (bez pomiaru) - pierwsze kroki skryptu daja opoznienia
+    for (int i = 0; i < liczbaPoczatkowa; i++) {
+        zaplanujZegar(kolejka, i, kroki[i].opoznienie);
+        aktywne.dodaj(i);
+    }
+
+    unsigned long long czas = 0;
+    unsigned long long anulowane = 0;
+    unsigned long long wygasle = 0;
+    int nastepnyId = liczbaPoczatkowa;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int k = 0; k < liczbaKrokow; k++) {
+        const KrokZegarow& krok = kroki[k];
+        czas++;
+
+        zaplanujZegar(kolejka, nastepnyId, czas + krok.opoznienie);
+        aktywne.dodaj(nastepnyId);
+        nastepnyId++;
+
+        if (krok.anuluj && aktywne.liczba > 0) {
+            int id = aktywne.zegary[krok.wybor % aktywne.liczba];
+            anulujZegar(kolejka, id);
+            aktywne.usun(id);
+            anulowane++;
+        }
+
+        int liczba;
+        while ((liczba = odbierzWygasle(kolejka, czas, bufor, ROZMIAR_PACZKI)) > 0) {
+            for (int i = 0; i < liczba; i++) {
+                aktywne.usun(bufor[i]);
+            }
+            wygasle += liczba;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double nsNaKrok = std::chrono::duration<double, std::nano>(end - start).count() / liczbaKrokow;
+
+    std::cout << nazwaKolejki << ": " << nsNaKrok << " ns/krok, anulowane " << anulowane
+        << ", wygasle " << wygasle << ", aktywne na koniec " << aktywne.liczba
+        << ", pamiec " << kolejka.memoryUsage() << " B" << std::endl;
+
+    plikWynikow << nazwaKolejki << ","
+        << liczbaPoczatkowa << ","
+        << liczbaKrokow << ","
+        << nsNaKrok << ","
+        << anulowane << ","
+        << wygasle << ","
+        << kolejka.memoryUsage() << std::endl;
+}
+
+// Funkcja do testowania kola czasowego na obciazeniu zegarow (wiekszosc zegarow jest anulowana)
+void uruchomTestZegarow() {
+    int liczbaKrokow;
+    std::cout << "Podaj liczbe krokow (np. 20000): ";
+    std::cin >> liczbaKrokow;
+    if (std::cin.fail() || liczbaKrokow <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba krokow." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_zegarow.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Kolejka,AktywneNaStart,Kroki,Czas(ns/krok),Anulowane,Wygasle,Pamiec(B)" << std::endl;
+
+    const int LICZBY_AKTYWNYCH[] = { 1000, 10000, 100000 };
+    const int LICZBA_ROZMIAROW = sizeof(LICZBY_AKTYWNYCH) / sizeof(LICZBY_AKTYWNYCH[0]);
+    const double PRAWDOPODOBIENSTWO_ANULOWANIA = 0.9;
+
+    for (int r = 0; r < LICZBA_ROZMIAROW; r++) {
+        int liczbaAktywnych = LICZBY_AKTYWNYCH[r];
+        int dlugoscSkryptu = liczbaAktywnych > liczbaKrokow ? liczbaAktywnych : liczbaKrokow;
+        std::cout << "\n=== ZEGARY: " << liczbaAktywnych << " aktywnych, " << liczbaKrokow << " krokow ===" << std::endl;
+
+        // Terminy w horyzoncie 10x liczby aktywnych zegarow, ten sam skrypt dla kazdej kolejki
+        std::mt19937 generator(2024 + r);
+        std::uniform_int_distribution<unsigned long long> rozkladOpoznien(1, 10ULL * liczbaAktywnych);
+        std::uniform_real_distribution<double> rozkladAnulowania(0.0, 1.0);
+        KrokZegarow* kroki = new KrokZegarow[dlugoscSkryptu];
+        for (int k = 0; k < dlugoscSkryptu; k++) {
+            kroki[k].opoznienie = rozkladOpoznien(generator);
+            kroki[k].anuluj = rozkladAnulowania(generator) < PRAWDOPODOBIENSTWO_ANULOWANIA;
+            kroki[k].wybor = (unsigned int)generator();
+        }
+
+        {
+            KopiecTerminow kolejka;
+            testujObciazenieZegarow(plikWynikow, "KOPIEC", kolejka, liczbaAktywnych, kroki, liczbaKrokow);
+        }
+        {
+            KoloZUchwytami kolejka(liczbaAktywnych + liczbaKrokow);
+            testujObciazenieZegarow(plikWynikow, "KOLO CZASOWE", kolejka, liczbaAktywnych, kroki, liczbaKrokow);
+        }
+        {
+            TimingWheelPriorityQueue<int> kolejka;
+            testujObciazenieZegarow(plikWynikow, "KOLO CZASOWE (ADAPTER)", kolejka, liczbaAktywnych, kroki, liczbaKrokow);
+        }
+        plikWynikow.flush();
+
+        delete[] kroki;
+    }
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_zegarow.csv" << std::endl;
+}
+
+// Jedna operacja obciazenia w tescie trwalosci - wspolny skrypt dla kazdej konfiguracji
+struct OperacjaTrwalosci {
+    int rodzaj;      // 0 - insert, 1 - extractMax, 2 - modifyKey najlepszego elementu
+    int priorytet;
+};
+
+// Wykonanie skryptu na dowolnej kolejce (zwykla albo trwala) - zwraca czas w sekundach
+template <typename PQ>
+double wykonajOperacjeTrwalosci(PQ& kolejka, const OperacjaTrwalosci* operacje, int liczbaOperacji) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < liczbaOperacji; i++) {
+        const OperacjaTrwalosci& operacja = operacje[i];
+        if (operacja.rodzaj == 0 || kolejka.isEmpty()) {
+            kolejka.insert(i, operacja.priorytet);
+        }
+        else if (operacja.rodzaj == 1) {
+            kolejka.extractMax();
+        }
+        else {
+            kolejka.modifyKey(kolejka.findMax(), operacja.priorytet);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// Funkcja do testowania przepustowosci kolejki trwalej (dziennik + group commit) wzgledem zwyklej kolejki
+void uruchomTestTrwalosci() {
+    int liczbaOperacji;
+    std::cout << "Podaj liczbe operacji (np. 200000): ";
+    std::cin >> liczbaOperacji;
+    if (std::cin.fail() || liczbaOperacji <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba operacji." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_trwalosci.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Tryb,GrupaCommit,Operacje,Czas(s),Operacje/s,Fsync,Dziennik(B),Migawki(B),Odtworzenie(ms)" << std::endl;
+
+    // Skrypt: 55% insert, 44% extractMax, 1% modifyKey - kolejka powoli rosnie
+    std::mt19937 generator(4242);
+    std::uniform_int_distribution<int> rozkladRodzaju(0, 99);
+    std::uniform_int_distribution<int> rozkladPriorytetow(0, 1000000);
+    OperacjaTrwalosci* operacje = new OperacjaTrwalosci[liczbaOperacji];
+    for (int i = 0; i < liczbaOperacji; i++) {
+        int los = rozkladRodzaju(generator);
+        operacje[i].rodzaj = los < 55 ? 0 : (los < 99 ? 1 : 2);
+        operacje[i].priorytet = rozkladPriorytetow(generator);
+    }
+
+    // Bez trwalosci
+    {
+        HeapPriorityQueue<int> kolejka;
+        double czas = wykonajOperacjeTrwalosci(kolejka, operacje, liczbaOperacji);
+        std::cout << "\nBEZ TRWALOSCI: " << liczbaOperacji / czas << " op/s" << std::endl;
+        plikWynikow << "bez trwalosci,0," << liczbaOperacji << "," << czas << "," << liczbaOperacji / czas
+            << ",0,0,0,0" << std::endl;
+    }
+
+    // Z dziennikiem - fsync co GRUPA rekordow; fsync na kazda operacje jest bardzo wolny,
+    // wiec dla grupy 1 wykonywana jest tylko czesc skryptu (wynik w op/s jest porownywalny)
+    const std::size_t GRUPY[] = { 1, 16, 256, 4096 };
+    const int LICZBA_GRUP = sizeof(GRUPY) / sizeof(GRUPY[0]);
+    const std::string PREFIKS = "kolejka_trwala_test";
+
+    for (int g = 0; g < LICZBA_GRUP; g++) {
+        std::size_t grupa = GRUPY[g];
+        int operacjeGrupy = grupa == 1 && liczbaOperacji > 2000 ? 2000 : liczbaOperacji;
+
+        std::remove((PREFIKS + ".snap").c_str());
+        std::remove((PREFIKS + ".wal").c_str());
+
+        try {
+            double czas;
+            unsigned long long fsync, dziennik, migawki;
+            std::size_t rozmiar;
+            {
+                DurablePriorityQueue<int> kolejka(PREFIKS, grupa, 100000);
+                czas = wykonajOperacjeTrwalosci(kolejka, operacje, operacjeGrupy);
+                kolejka.sync();
+                fsync = kolejka.returnSyncCount();
+                dziennik = kolejka.returnLogBytes();
+                migawki = kolejka.returnSnapshotBytes();
+                rozmiar = kolejka.returnSize();
+            }
+
+            // Odtworzenie po ponownym uruchomieniu: migawka + powtorzenie dziennika
+            auto start = std::chrono::high_resolution_clock::now();
+            DurablePriorityQueue<int> odtworzona(PREFIKS, grupa, 100000);
+            auto end = std::chrono::high_resolution_clock::now();
+            double msOdtworzenia = std::chrono::duration<double, std::milli>(end - start).count();
+            if (odtworzona.returnSize() != rozmiar) {
+                std::cerr << "Blad: odtworzona kolejka ma " << odtworzona.returnSize()
+                    << " elementow zamiast " << rozmiar << std::endl;
+            }
+
+            std::cout << "DZIENNIK, grupa " << grupa << ": " << operacjeGrupy / czas << " op/s, fsync: " << fsync
+                << ", dziennik: " << dziennik << " B, odtworzenie: " << msOdtworzenia << " ms" << std::endl;
+            plikWynikow << "dziennik," << grupa << "," << operacjeGrupy << "," << czas << "," << operacjeGrupy / czas << ","
+                << fsync << "," << dziennik << "," << migawki << "," << msOdtworzenia << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Blad: " << e.what() << std::endl;
+        }
+    }
+
+    std::remove((PREFIKS + ".snap").c_str());
+    std::remove((PREFIKS + ".wal").c_str());
+    delete[] operacje;
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_trwalosci.csv" << std::endl;
+}
+
+// Funkcja do testowania zapisu w tle - opoznienia operacji pierwszoplanowych podczas zapisu
+void uruchomTestZapisuWTle() {
+    int rozmiar;
+    std::cout << "Podaj rozmiar kolejki (np. 1000000): ";
+    std::cin >> rozmiar;
+    if (std::cin.fail() || rozmiar <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowy rozmiar." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_zapisu_w_tle.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Faza,Operacje,p50(ns),p99(ns),p99.9(ns),Max(ns),PierwszaOperacja(ns),CzasZapisu(ms)" << std::endl;
+
+    const std::string PLIK_ZAPISU = "kolejka_zapis_w_tle.txt";
+    const int OPERACJE_BAZOWE = 200000;
+
+    std::mt19937 generator(99);
+    std::uniform_int_distribution<int> rozkladPriorytetow(0, 1000000);
+    HeapPriorityQueue<int> kolejka;
+    for (int i = 0; i < rozmiar; i++) {
+        kolejka.insert(i, rozkladPriorytetow(generator));
+    }
+
+    // Para insert + extractMax jako jedna operacja pierwszoplanowa (rozmiar kolejki stoi w miejscu)
+    int nastepnyElement = rozmiar;
+    auto operacja = [&]() {
+        kolejka.insert(nastepnyElement++, rozkladPriorytetow(generator));
+        kolejka.extractMax();
+    };
+
+    // Faza bazowa - bez zapisu
+    LatencyHistogram histogramBazowy;
+    for (int i = 0; i < OPERACJE_BAZOWE; i++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        operacja();
+        auto end = std::chrono::high_resolution_clock::now();
+        histogramBazowy.record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    // Zapis synchroniczny - tyle trwa przestoj kolejki
+    auto startSync = std::chrono::high_resolution_clock::now();
+    bool sukcesSync = zapiszDoPliku(kolejka, PLIK_ZAPISU);
+    auto endSync = std::chrono::high_resolution_clock::now();
+    double msSync = std::chrono::duration<double, std::milli>(endSync - startSync).count();
+
+    // Zapis w tle - operacje pierwszoplanowe trwaja do zakonczenia zapisu
+    LatencyHistogram histogramWTle;
+    auto startAsync = std::chrono::high_resolution_clock::now();
+    std::future<bool> zapis = saveAsync(kolejka, PLIK_ZAPISU);
+    auto endMigawki = std::chrono::high_resolution_clock::now();
+    long long nsPierwszej = 0;
+    unsigned long long operacjeWTle = 0;
+    while (zapis.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        auto start = std::chrono::high_resolution_clock::now();
+        operacja();
+        auto end = std::chrono::high_resolution_clock::now();
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        if (operacjeWTle == 0) {
+            nsPierwszej = ns;   // pierwsza modyfikacja po migawce kopiuje zmieniane strony migawki
+        }
+        histogramWTle.record(ns);
+        operacjeWTle++;
+    }
+    bool sukcesAsync = zapis.get();
+    auto endAsync = std::chrono::high_resolution_clock::now();
+    double msAsync = std::chrono::duration<double, std::milli>(endAsync - startAsync).count();
+    long long nsMigawki = std::chrono::duration_cast<std::chrono::nanoseconds>(endMigawki - startAsync).count();
+
+    if (!sukcesSync || !sukcesAsync) {
+        std::cerr << "Blad: zapis do pliku " << PLIK_ZAPISU << " nie powiodl sie." << std::endl;
+    }
+
+    std::cout << "\n=== ZAPIS W TLE: " << rozmiar << " elementow ===" << std::endl;
+    std::cout << "Bez zapisu: p99 " << histogramBazowy.valueAtPercentile(99.0) << " ns, max "
+        << histogramBazowy.max() << " ns" << std::endl;
+    std::cout << "Zapis synchroniczny: kolejka zablokowana na " << msSync << " ms" << std::endl;
+    std::cout << "Zapis w tle: " << msAsync << " ms, migawka " << nsMigawki << " ns, " << operacjeWTle
+        << " operacji w trakcie, p99 " << histogramWTle.valueAtPercentile(99.0) << " ns, max "
+        << histogramWTle.max() << " ns, pierwsza operacja " << nsPierwszej << " ns" << std::endl;
+
+    plikWynikow << "bez zapisu," << histogramBazowy.totalCount() << ","
+        << histogramBazowy.valueAtPercentile(50.0) << "," << histogramBazowy.valueAtPercentile(99.0) << ","
+        << histogramBazowy.valueAtPercentile(99.9) << "," << histogramBazowy.max() << ",0,0" << std::endl;
+    plikWynikow << "zapis synchroniczny,0,0,0,0,0,0," << msSync << std::endl;
+    plikWynikow << "zapis w tle," << histogramWTle.totalCount() << ","
+        << histogramWTle.valueAtPercentile(50.0) << "," << histogramWTle.valueAtPercentile(99.0) << ","
+        << histogramWTle.valueAtPercentile(99.9) << "," << histogramWTle.max() << ","
+        << nsPierwszej << "," << msAsync << std::endl;
+
+    std::remove(PLIK_ZAPISU.c_str());
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_zapisu_w_tle.csv" << std::endl;
 }
 
-int main() {
+// Funkcja do testowania budowy i eksportu rownoleglego dla roznych liczb watkow
+void uruchomTestRownoleglosci() {
+    int rozmiar;
+    std::cout << "Podaj liczbe elementow (np. 10000000): ";
+    std::cin >> rozmiar;
+    if (std::cin.fail() || rozmiar <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba elementow." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_rownoleglosci.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Operacja,Watki,Elementy,Czas(ms),Przyspieszenie" << std::endl;
+
+    const std::string PLIK_EKSPORTU = "kolejka_eksport_test.txt";
+    std::mt19937 generator(31337);
+    std::uniform_int_distribution<int> rozkladPriorytetow(0, 1000000);
+    int* elementy = new int[rozmiar];
+    int* priorytety = new int[rozmiar];
+    for (int i = 0; i < rozmiar; i++) {
+        elementy[i] = i;
+        priorytety[i] = rozkladPriorytetow(generator);
+    }
+
+    // Punkt odniesienia - kolejne insert w jednym watku
+    {
+        HeapPriorityQueue<int> kolejka;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < rozmiar; i++) {
+            kolejka.insert(elementy[i], priorytety[i]);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        std::cout << "\nInsert po kolei: " << ms << " ms" << std::endl;
+        plikWynikow << "insert po kolei,1," << rozmiar << "," << ms << ",1" << std::endl;
+    }
+
+    // Liczby watkow: 1, 2, 4, ... az do ustawionej liczby watkow
+    double msBudowy1 = 0;
+    double msEksportu1 = 0;
+    for (unsigned watki = 1; ; watki = watki * 2 < liczbaWatkow ? watki * 2 : liczbaWatkow) {
+        HeapPriorityQueue<int> kolejka;
+        auto start = std::chrono::high_resolution_clock::now();
+        kolejka.bulkLoad(elementy, priorytety, rozmiar, watki);
+        auto end = std::chrono::high_resolution_clock::now();
+        double msBudowy = std::chrono::duration<double, std::milli>(end - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        bool sukces = writeSnapshotFile(kolejka.snapshot(), PLIK_EKSPORTU, watki);
+        end = std::chrono::high_resolution_clock::now();
+        double msEksportu = std::chrono::duration<double, std::milli>(end - start).count();
+        if (!sukces) {
+            std::cerr << "Blad: eksport do pliku " << PLIK_EKSPORTU << " nie powiodl sie." << std::endl;
+        }
+
+        // Kontrola poprawnosci - kolejne extractMax musza dawac nierosnace priorytety
+        int poprzedni = kolejka.findMaxPriority();
+        for (int i = 0; i < 1000 && !kolejka.isEmpty(); i++) {
+            int biezacy = kolejka.findMaxPriority();
+            if (biezacy > poprzedni) {
+                std::cerr << "Blad: kopiec zbudowany na " << watki << " watkach jest niepoprawny." << std::endl;
+                break;
+            }
+            poprzedni = biezacy;
+            kolejka.extractMax();
+        }
+
+        if (watki == 1) {
+            msBudowy1 = msBudowy;
+            msEksportu1 = msEksportu;
+        }
+        std::cout << "Watki: " << watki << ", budowa hurtowa: " << msBudowy << " ms (x" << msBudowy1 / msBudowy
+            << "), eksport: " << msEksportu << " ms (x" << msEksportu1 / msEksportu << ")" << std::endl;
+        plikWynikow << "budowa hurtowa," << watki << "," << rozmiar << "," << msBudowy << "," << msBudowy1 / msBudowy << std::endl;
+        plikWynikow << "eksport," << watki << "," << rozmiar << "," << msEksportu << "," << msEksportu1 / msEksportu << std::endl;
+
+        if (watki >= liczbaWatkow) {
+            break;
+        }
+    }
+
+    std::remove(PLIK_EKSPORTU.c_str());
+    delete[] elementy;
+    delete[] priorytety;
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_rownoleglosci.csv" << std::endl;
+}
+
+// Zadanie testowe harmonogramu: chwila obliczen i (do maksymalnej glebokosci) dwa zadania potomne
+// o losowych priorytetach - zadania powstaja w kolejkach watkow, wiec potrzebna jest kradziez
+std::atomic<unsigned int> wynikZadanTestowych(0);
+
+struct ZadanieTestowe {
+    PriorityTaskScheduler* harmonogram;
+    unsigned int ziarno;
+    int glebokosc;
+
+    void operator()() const {
+        unsigned int x = ziarno | 1u;
+        for (int i = 0; i < 256; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+        }
+        wynikZadanTestowych.fetch_add(x & 1u, std::memory_order_relaxed);
+
+        if (glebokosc > 0) {
+            for (unsigned int dziecko = 1; dziecko <= 2; dziecko++) {
+                ZadanieTestowe potomne = { harmonogram, ziarno * 2654435761u + dziecko, glebokosc - 1 };
+                harmonogram->submit(potomne, (int)((potomne.ziarno >> 8) % 100));
+            }
+        }
+    }
+};
+
+// Funkcja do testowania harmonogramu zadan: zadania/s i inwersje priorytetow dla roznej liczby watkow
+void uruchomTestHarmonogramu() {
+    int liczbaKorzeni;
+    std::cout << "Podaj liczbe zadan poczatkowych (np. 2000, kazde tworzy drzewo 255 zadan): ";
+    std::cin >> liczbaKorzeni;
+    if (std::cin.fail() || liczbaKorzeni <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba zadan." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_harmonogramu.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Watki,Zadania,Czas(s),Zadania/s,Kradzieze,SkradzioneZadania,Inwersje,Inwersje(%)" << std::endl;
+
+    const int GLEBOKOSC = 7;
+    std::cout << "\n=== HARMONOGRAM ZADAN: " << liczbaKorzeni * 255 << " zadan ===" << std::endl;
+
+    for (unsigned watki = 1; ; watki = watki * 2 < liczbaWatkow ? watki * 2 : liczbaWatkow) {
+        PriorityTaskScheduler harmonogram(watki);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int k = 0; k < liczbaKorzeni; k++) {
+            ZadanieTestowe korzen = { &harmonogram, 2166136261u ^ (unsigned int)k, GLEBOKOSC };
+            harmonogram.submit(korzen, (int)((korzen.ziarno >> 8) % 100));
+        }
+        harmonogram.waitIdle();
+        auto end = std::chrono::high_resolution_clock::now();
+        double sekundy = std::chrono::duration<double>(end - start).count();
+
+        unsigned long long wykonane = harmonogram.returnExecuted();
+        double procentInwersji = 100.0 * harmonogram.returnInversions() / wykonane;
+        std::cout << "Watki: " << watki << ", " << wykonane / sekundy << " zadan/s, kradzieze: "
+            << harmonogram.returnSteals() << " (" << harmonogram.returnStolen() << " zadan), inwersje: "
+            << harmonogram.returnInversions() << " (" << procentInwersji << "%)" << std::endl;
+        plikWynikow << watki << "," << wykonane << "," << sekundy << "," << wykonane / sekundy << ","
+            << harmonogram.returnSteals() << "," << harmonogram.returnStolen() << ","
+            << harmonogram.returnInversions() << "," << procentInwersji << std::endl;
+
+        if (watki >= liczbaWatkow) {
+            break;
+        }
+    }
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_harmonogramu.csv" << std::endl;
+}
+
+// Model hold dla symulacji: kazde obsluzone zdarzenie planuje dokladnie jedno nastepne, wiec
+// liczba zdarzen w kolejce jest stala; przyrosty czasu pochodza z gotowego skryptu (ten sam dla kazdej kolejki)
+struct ModelHold {
+    const SimulationTime* przyrosty;
+    int liczbaPrzyrostow;
+    int nastepny;
+
+    template <typename Symulacja>
+    void operator()(const SimulationEvent& zdarzenie, Symulacja& symulacja) {
+        symulacja.schedule(przyrosty[nastepny], zdarzenie.type, zdarzenie.data);
+        nastepny = nastepny + 1 < liczbaPrzyrostow ? nastepny + 1 : 0;
+    }
+};
+
+// Szablon funkcji mierzacej model hold: wypelnienie kolejki, rozgrzewka (rozmiar operacji, bez pomiaru)
+// i pomiar liczbaOperacji par extractMax + insert w petli symulacji
+template <typename Kolejka>
+void testujModelHold(std::ofstream& plikWynikow,
+    const std::string& nazwaKolejki,
+    Kolejka& kolejka,
+    int rozmiar,
+    const std::string& nazwaRozkladu,
+    const SimulationTime* przyrosty,
+    int liczbaPrzyrostow,
+    int liczbaOperacji) {
+    DiscreteEventSimulation<Kolejka> symulacja(kolejka);
+    ModelHold model = { przyrosty, liczbaPrzyrostow, 0 };
+
+    for (int i = 0; i < rozmiar; i++) {
+        symulacja.schedule(przyrosty[model.nastepny++], 0, i);
+    }
+    symulacja.flush();
+    symulacja.run(model, rozmiar);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    unsigned long long obsluzone = symulacja.run(model, liczbaOperacji);
+    auto end = std::chrono::high_resolution_clock::now();
+    double nsNaOperacje = std::chrono::duration<double, std::nano>(end - start).count() / obsluzone;
+
+    std::cout << nazwaKolejki << ": " << nsNaOperacje << " ns/hold, czas symulacji "
+        << symulacja.currentTime() << ", w kolejce " << symulacja.returnPending()
+        << ", pamiec " << symulacja.memoryUsage() << " B" << std::endl;
+
+    plikWynikow << nazwaKolejki << ","
+        << rozmiar << ","
+        << nazwaRozkladu << ","
+        << obsluzone << ","
+        << nsNaOperacje << ","
+        << symulacja.currentTime() << ","
+        << symulacja.memoryUsage() << std::endl;
+}
+
+// Funkcja do testowania kolejek jako listy zdarzen symulacji (model hold) dla roznych rozmiarow i rozkladow
+void uruchomTestSymulacji() {
+    int liczbaOperacji;
+    std::cout << "Podaj liczbe operacji hold na pomiar (np. 1000000): ";
+    std::cin >> liczbaOperacji;
+    if (std::cin.fail() || liczbaOperacji <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba operacji." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_symulacji.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Kolejka,Rozmiar,Rozklad,Operacje,Czas(ns/hold),CzasSymulacji,Pamiec(B)" << std::endl;
+
+    typedef HeapPriorityQueue<SimulationEvent, SimulationTime, std::greater<SimulationTime> > KopiecZdarzen;
+    typedef ArrayPriorityQueue<SimulationEvent, SimulationTime, std::greater<SimulationTime> > TablicaZdarzen;
+    typedef BlockedHeapPriorityQueue<SimulationEvent, SimulationTime, std::greater<SimulationTime> > KopiecBlokowyZdarzen;
+    typedef SequenceHeap<SimulationEvent, SimulationTime, std::greater<SimulationTime> > KopiecSekwencjiZdarzen;
+    typedef ExternalPriorityQueue<SimulationEvent, SimulationTime, std::greater<SimulationTime> > KolejkaZewnetrznaZdarzen;
+    typedef TimingWheelPriorityQueue<SimulationEvent, SimulationEventHash> KoloZdarzen;
+
+    const int ROZMIARY[] = { 100, 10000, 1000000 };
+    const int LICZBA_ROZMIAROW = sizeof(ROZMIARY) / sizeof(ROZMIARY[0]);
+    const int MAKS_ROZMIAR_TABLICY = 10000;     // tablica ma extractMax O(n)
+    const std::size_t BUDZET_ZEWNETRZNEJ = 8u << 20;
+    const char* ROZKLADY[] = { "wykladniczy", "jednostajny", "dwumodalny", "trojkatny" };
+    const int LICZBA_ROZKLADOW = sizeof(ROZKLADY) / sizeof(ROZKLADY[0]);
+    const double SREDNI_PRZYROST = 1000.0;      // w tickach
+
+    for (int r = 0; r < LICZBA_ROZMIAROW; r++) {
+        int rozmiar = ROZMIARY[r];
+        int liczbaPrzyrostow = 2 * rozmiar + liczbaOperacji;
+
+        for (int d = 0; d < LICZBA_ROZKLADOW; d++) {
+            std::cout << "\n=== MODEL HOLD: " << rozmiar << " zdarzen, rozklad " << ROZKLADY[d]
+                << ", " << liczbaOperacji << " operacji ===" << std::endl;
+
+            // Klasyczne rozklady przyrostow modelu hold o tej samej sredniej
+            std::mt19937 generator(4040 + r * LICZBA_ROZKLADOW + d);
+            std::exponential_distribution<double> wykladniczy(1.0 / SREDNI_PRZYROST);
+            std::uniform_real_distribution<double> jednostajny(0.0, 1.0);
+            SimulationTime* przyrosty = new SimulationTime[liczbaPrzyrostow];
+            for (int i = 0; i < liczbaPrzyrostow; i++) {
+                double przyrost;
+                if (d == 0) {
+                    przyrost = wykladniczy(generator);
+                }
+                else if (d == 1) {
+                    przyrost = 2.0 * SREDNI_PRZYROST * jednostajny(generator);
+                }
+                else if (d == 2) {
+                    // 95% krotkich przyrostow i 5% bardzo dlugich
+                    przyrost = jednostajny(generator) < 0.95 ? 0.1 * SREDNI_PRZYROST * jednostajny(generator)
+                        : 38.1 * SREDNI_PRZYROST * jednostajny(generator);
+                }
+                else {
+                    przyrost = SREDNI_PRZYROST * (jednostajny(generator) + jednostajny(generator));
+                }
+                przyrosty[i] = (SimulationTime)przyrost;
+            }
+
+            {
+                KopiecZdarzen kolejka;
+                testujModelHold(plikWynikow, "KOPIEC", kolejka, rozmiar, ROZKLADY[d], przyrosty, liczbaPrzyrostow, liczbaOperacji);
+            }
+            if (rozmiar <= MAKS_ROZMIAR_TABLICY) {
+                TablicaZdarzen kolejka;
+                testujModelHold(plikWynikow, "TABLICA", kolejka, rozmiar, ROZKLADY[d], przyrosty, liczbaPrzyrostow, liczbaOperacji);
+            }
+            {
+                KopiecBlokowyZdarzen kolejka;
+                testujModelHold(plikWynikow, "KOPIEC BLOKOWY", kolejka, rozmiar, ROZKLADY[d], przyrosty, liczbaPrzyrostow, liczbaOperacji);
+            }
+            {
+                KopiecSekwencjiZdarzen kolejka;
+                testujModelHold(plikWynikow, "KOPIEC SEKWENCJI", kolejka, rozmiar, ROZKLADY[d], przyrosty, liczbaPrzyrostow, liczbaOperacji);
+            }
+            try {
+                KolejkaZewnetrznaZdarzen kolejka(BUDZET_ZEWNETRZNEJ, BUDZET_ZEWNETRZNEJ / 64);
+                testujModelHold(plikWynikow, "PAMIEC ZEWNETRZNA", kolejka, rozmiar, ROZKLADY[d], przyrosty, liczbaPrzyrostow, liczbaOperacji);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Blad: " << e.what() << std::endl;
+            }
+            {
+                KoloZdarzen kolejka;
+                testujModelHold(plikWynikow, "KOLO CZASOWE", kolejka, rozmiar, ROZKLADY[d], przyrosty, liczbaPrzyrostow, liczbaOperacji);
+            }
+            plikWynikow.flush();
+
+            delete[] przyrosty;
+        }
+    }
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_symulacji.csv" << std::endl;
+}
+
+// Szablon funkcji mierzacej jeden przebieg algorytmu grafowego (0 - Dijkstra, 1 - Prim, 2 - A*)
+// na danej kolejce; Update to strategia poprawy klucza (increaseKey albo leniwe wstawienia)
+template <typename Update, typename Kolejka>
+void testujAlgorytmGrafowy(std::ofstream& plikWynikow,
+    int algorytm,
+    const std::string& nazwaGrafu,
+    const Graph& graf,
+    const std::string& nazwaKolejki,
+    Kolejka& kolejka) {
+    const char* NAZWY_ALGORYTMOW[] = { "Dijkstra", "Prim", "A*" };
+    int cel = (int)graf.vertexCount() - 1;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    GraphRunStats statystyki;
+    if (algorytm == 0) {
+        statystyki = runDijkstra<Update>(graf, 0, kolejka);
+    }
+    else if (algorytm == 1) {
+        statystyki = runPrim<Update>(graf, 0, kolejka);
+    }
+    else {
+        statystyki = runAStar<Update>(graf, 0, cel, kolejka);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double czasMs = std::chrono::duration<double, std::milli>(end - start).count();
+    double nsNaOperacje = czasMs * 1e6 / statystyki.operations();
+
+    std::cout << "  " << nazwaKolejki << ": " << czasMs << " ms, wstawienia " << statystyki.inserts
+        << ", wyjecia " << statystyki.extracts << ", poprawy kluczy " << statystyki.keyUpdates
+        << ", " << nsNaOperacje << " ns/op, wynik " << statystyki.result << std::endl;
+
+    plikWynikow << NAZWY_ALGORYTMOW[algorytm] << ","
+        << nazwaGrafu << ","
+        << graf.vertexCount() << ","
+        << graf.edgeCount() << ","
+        << nazwaKolejki << ","
+        << czasMs << ","
+        << statystyki.inserts << ","
+        << statystyki.extracts << ","
+        << statystyki.keyUpdates << ","
+        << statystyki.staleSkips << ","
+        << nsNaOperacje << ","
+        << statystyki.result << std::endl;
+}
+
+// Funkcja do testowania kolejek w algorytmach grafowych (Dijkstra, Prim, A*) na siatce,
+// losowym grafie rzadkim i grafie bezskalowym o rosnacym rozmiarze
+void uruchomTestGrafow() {
+    int maksWierzcholkow;
+    std::cout << "Podaj maksymalna liczbe wierzcholkow (np. 100000): ";
+    std::cin >> maksWierzcholkow;
+    if (std::cin.fail() || maksWierzcholkow < 4) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba wierzcholkow." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_grafow.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Algorytm,Graf,Wierzcholki,Krawedzie,Kolejka,Czas(ms),Wstawienia,Wyjecia,PoprawyKluczy,PominietePrzestarzale,Czas(ns/op),Wynik" << std::endl;
+
+    typedef std::greater<GraphDistance> Minimum;
+    typedef HeapPriorityQueue<int, GraphDistance, Minimum> KopiecOdleglosci;
+    typedef ArrayPriorityQueue<int, GraphDistance, Minimum> TablicaOdleglosci;
+    typedef BlockedHeapPriorityQueue<int, GraphDistance, Minimum> KopiecBlokowyOdleglosci;
+    typedef SequenceHeap<int, GraphDistance, Minimum> KopiecSekwencjiOdleglosci;
+    typedef ExternalPriorityQueue<int, GraphDistance, Minimum> KolejkaZewnetrznaOdleglosci;
+
+    // increaseKey w kopcach i tablicy szuka elementu liniowo - wieksze grafy tylko dla innych kolejek
+    const int MAKS_WYSZUKIWANIA_LINIOWEGO = 10000;
+    const std::size_t BUDZET_ZEWNETRZNEJ = 8u << 20;
+    const char* NAZWY_GRAFOW[] = { "siatka", "losowy", "bezskalowy" };
+
+    for (int rozmiar = maksWierzcholkow < 1000 ? maksWierzcholkow : 1000; ; rozmiar = rozmiar * 10 < maksWierzcholkow ? rozmiar * 10 : maksWierzcholkow) {
+        for (int rodzaj = 0; rodzaj < 3; rodzaj++) {
+            Graph graf;
+            if (rodzaj == 0) {
+                int bok = (int)std::sqrt((double)rozmiar);
+                makeGridGraph(graf, bok, 4100 + rozmiar);
+            }
+            else if (rodzaj == 1) {
+                makeRandomGraph(graf, rozmiar, 6, 4100 + rozmiar);
+            }
+            else {
+                makePowerLawGraph(graf, rozmiar, 3, 4100 + rozmiar);
+            }
+            bool liniowe = (int)graf.vertexCount() <= MAKS_WYSZUKIWANIA_LINIOWEGO;
+
+            for (int algorytm = 0; algorytm < 3; algorytm++) {
+                const char* NAZWY_ALGORYTMOW[] = { "DIJKSTRA", "PRIM", "A*" };
+                std::cout << "\n=== " << NAZWY_ALGORYTMOW[algorytm] << ": graf " << NAZWY_GRAFOW[rodzaj] << ", "
+                    << graf.vertexCount() << " wierzcholkow, " << graf.edgeCount() << " krawedzi ===" << std::endl;
+
+                if (liniowe) {
+                    KopiecOdleglosci kolejka;
+                    testujAlgorytmGrafowy<DecreaseKeyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "KOPIEC (increaseKey)", kolejka);
+                }
+                {
+                    KopiecOdleglosci kolejka;
+                    testujAlgorytmGrafowy<LazyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "KOPIEC (leniwy)", kolejka);
+                }
+                if (liniowe) {
+                    TablicaOdleglosci kolejka;
+                    testujAlgorytmGrafowy<DecreaseKeyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "TABLICA (increaseKey)", kolejka);
+                }
+                if (liniowe) {
+                    KopiecBlokowyOdleglosci kolejka;
+                    testujAlgorytmGrafowy<DecreaseKeyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "KOPIEC BLOKOWY (increaseKey)", kolejka);
+                }
+                {
+                    KopiecBlokowyOdleglosci kolejka;
+                    testujAlgorytmGrafowy<LazyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "KOPIEC BLOKOWY (leniwy)", kolejka);
+                }
+                {
+                    KopiecSekwencjiOdleglosci kolejka;
+                    testujAlgorytmGrafowy<LazyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "KOPIEC SEKWENCJI (leniwy)", kolejka);
+                }
+                try {
+                    KolejkaZewnetrznaOdleglosci kolejka(BUDZET_ZEWNETRZNEJ, BUDZET_ZEWNETRZNEJ / 64);
+                    testujAlgorytmGrafowy<LazyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "PAMIEC ZEWNETRZNA (leniwy)", kolejka);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Blad: " << e.what() << std::endl;
+                }
+                // Kolo czasowe wymaga niemalejacych terminow - klucze Prima nie sa monotoniczne
+                if (algorytm != 1) {
+                    TimingWheelPriorityQueue<int> kolejka;
+                    testujAlgorytmGrafowy<DecreaseKeyUpdates>(plikWynikow, algorytm, NAZWY_GRAFOW[rodzaj], graf, "KOLO CZASOWE (increaseKey)", kolejka);
+                }
+                plikWynikow.flush();
+            }
+        }
+
+        if (rozmiar >= maksWierzcholkow) {
+            break;
+        }
+    }
+
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_grafow.csv" << std::endl;
+}
+
+// Szablon funkcji mierzacej cykl zycia malej kolejki: utworzenie, liczbaElementow wstawien,
+// wyjecie wszystkich elementow i zniszczenie (jak kolejka tworzona na czas jednego zadania)
+template <typename PQ>
+void testujMalaKolejke(std::ofstream& plikWynikow,
+    const std::string& nazwaKolejki,
+    int liczbaElementow,
+    const int* losowePriorytety,
+    int liczbaCykli) {
+    unsigned long long suma = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int c = 0; c < liczbaCykli; c++) {
+        PQ kolejka;
+        const int* priorytety = losowePriorytety + (c & 1023);
+        for (int i = 0; i < liczbaElementow; i++) {
+            kolejka.insert(i, priorytety[i]);
+        }
+        while (!kolejka.isEmpty()) {
+            suma += kolejka.extractMax();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double nsNaCykl = std::chrono::duration<double, std::nano>(end - start).count() / liczbaCykli;
+
+    PQ pelna;
+    for (int i = 0; i < liczbaElementow; i++) {
+        pelna.insert(i, losowePriorytety[i]);
+    }
+
+    std::cout << "  " << nazwaKolejki << ": " << nsNaCykl << " ns/cykl, "
+        << nsNaCykl / (2 * liczbaElementow) << " ns/op, pamiec " << pelna.memoryUsage()
+        << " B (suma kontrolna " << suma << ")" << std::endl;
+
+    plikWynikow << nazwaKolejki << ","
+        << liczbaElementow << ","
+        << liczbaCykli << ","
+        << nsNaCykl << ","
+        << nsNaCykl / (2 * liczbaElementow) << ","
+        << pelna.memoryUsage() << std::endl;
+}
+
+// Funkcja do testowania malych kolejek: kopiec z alokacja, kolejka o stalej pojemnosci (bez sterty)
+// i kopiec z buforem wewnetrznym (sterta dopiero powyzej 32 elementow)
+void uruchomTestMalychKolejek() {
+    int liczbaCykli;
+    std::cout << "Podaj liczbe cykli na rozmiar (np. 200000): ";
+    std::cin >> liczbaCykli;
+    if (std::cin.fail() || liczbaCykli <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba cykli." << std::endl;
+        return;
+    }
+
+    std::ofstream plikWynikow("wyniki_malych_kolejek.csv");
+    if (!plikWynikow.is_open()) {
+        std::cerr << "Blad  Nie mozna otworzyc pliku wynikow." << std::endl;
+        return;
+    }
+    plikWynikow << "Kolejka,Elementy,Cykle,Czas(ns/cykl),Czas(ns/op),Pamiec(B)" << std::endl;
+
+    const int POJEMNOSC_STALA = 128;
+    const int ROZMIARY[] = { 4, 8, 16, 32, 64, 128 };
+    const int LICZBA_ROZMIAROW = sizeof(ROZMIARY) / sizeof(ROZMIARY[0]);
+
+    std::mt19937 generator(4200);
+    std::uniform_int_distribution<int> rozkladPriorytetow(0, 1000000);
+    int* losowePriorytety = new int[1024 + POJEMNOSC_STALA];
+    for (int i = 0; i < 1024 + POJEMNOSC_STALA; i++) {
+        losowePriorytety[i] = rozkladPriorytetow(generator);
+    }
+
+    for (int r = 0; r < LICZBA_ROZMIAROW; r++) {
+        int liczbaElementow = ROZMIARY[r];
+        std::cout << "\n=== MALE KOLEJKI: " << liczbaElementow << " elementow, " << liczbaCykli << " cykli ===" << std::endl;
+
+        testujMalaKolejke<HeapPriorityQueue<int> >(plikWynikow, "KOPIEC", liczbaElementow, losowePriorytety, liczbaCykli);
+        testujMalaKolejke<FixedPriorityQueue<int, POJEMNOSC_STALA> >(plikWynikow, "KOPIEC O STALEJ POJEMNOSCI", liczbaElementow, losowePriorytety, liczbaCykli);
+        testujMalaKolejke<SmallHeapPriorityQueue<int, 32> >(plikWynikow, "KOPIEC Z BUFOREM (32)", liczbaElementow, losowePriorytety, liczbaCykli);
+        plikWynikow.flush();
+    }
+
+    delete[] losowePriorytety;
+    plikWynikow.close();
+    std::cout << "\nWyniki zostaly zapisane do pliku wyniki_malych_kolejek.csv" << std::endl;
+}
+
+// Funkcja do ustawienia liczby watkow dla budowy hurtowej, eksportu i zapisu w tle
+void ustawLiczbeWatkow() {
+    unsigned watki;
+    std::cout << "Aktualna liczba watkow: " << liczbaWatkow << " (procesor: "
+        << std::thread::hardware_concurrency() << ")" << std::endl;
+    std::cout << "Podaj nowa liczbe watkow: ";
+    std::cin >> watki;
+    if (std::cin.fail() || watki == 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Nieprawidlowa liczba watkow." << std::endl;
+        return;
+    }
+    liczbaWatkow = watki;
+    std::cout << "Liczba watkow ustawiona na " << liczbaWatkow << std::endl;
+}
+
+// Funkcja wypisujaca opcje wiersza polecen
+void wypiszUzycie(const char* program) {
+    std::cout << "Uzycie: " << program << " [opcje]" << std::endl;
+    std::cout << "  (bez opcji)                  menu interaktywne" << std::endl;
+    std::cout << "  --testy                      testy wydajnosci bez menu (kod wyjscia 2 przy bledzie)" << std::endl;
+    std::cout << "  --wyniki NAZWA               pliki pomiarow NAZWA.csv i NAZWA.json (domyslnie wyniki_wydajnosci)" << std::endl;
+    std::cout << "  --ziarno N                   ziarno danych testowych (domyslnie " << ziarnoTestow << ")" << std::endl;
+    std::cout << "  --porownaj BAZOWY NOWY       porownanie dwoch plikow CSV pomiarow (kod wyjscia 1 przy regresji)" << std::endl;
+    std::cout << "  --prog P                     minimalne pogorszenie mediany w % (domyslnie 10)" << std::endl;
+    std::cout << "  --prog-ns N                  minimalne pogorszenie mediany w ns (domyslnie 20)" << std::endl;
+    std::cout << "  --alfa A                     poziom istotnosci testu Manna-Whitneya (domyslnie 0.001)" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
     // Inicjalizacja generatora liczb losowych
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
 
+    // Opcje wiersza polecen (tryb bez menu - np. do sprawdzania regresji po zmianie naglowkow)
+    bool trybTestow = false;
+    std::string nazwaWynikow = "wyniki_wydajnosci";
+    std::string plikBazowy, plikNowy;
+    double prog = 10.0;
+    double progNs = 20.0;
+    double alfa = 0.001;
+    for (int i = 1; i < argc; i++) {
+        std::string opcja = argv[i];
+        bool maWartosc = i + 1 < argc;
+        if (opcja == "--testy") {
+            trybTestow = true;
+        }
+        else if (opcja == "--wyniki" && maWartosc) {
+            nazwaWynikow = argv[++i];
+        }
+        else if (opcja == "--ziarno" && maWartosc) {
+            ziarnoTestow = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (opcja == "--porownaj" && i + 2 < argc) {
+            plikBazowy = argv[++i];
+            plikNowy = argv[++i];
+        }
+        else if (opcja == "--prog" && maWartosc) {
+            prog = std::atof(argv[++i]);
+        }
+        else if (opcja == "--prog-ns" && maWartosc) {
+            progNs = std::atof(argv[++i]);
+        }
+        else if (opcja == "--alfa" && maWartosc) {
+            alfa = std::atof(argv[++i]);
+        }
+        else {
+            wypiszUzycie(argv[0]);
+            return 2;
+        }
+    }
+    if (!plikBazowy.empty()) {
+        return porownajWyniki(plikBazowy, plikNowy, prog, progNs, alfa);
+    }
+    if (trybTestow) {
+        return uruchomTestyWydajnosci(ziarnoTestow, nazwaWynikow) ? 0 : 2;
+    }
+
     // Utwórz kolejki priorytetowe
     HeapPriorityQueue<int> kolejkaKopca;
     ArrayPriorityQueue<int> kolejkaTablicy;
@@ -608,6 +2255,17 @@ int main() {
         std::cout << "1. Kolejka priorytetowa oparta na kopcu" << std::endl;
         std::cout << "2. Kolejka priorytetowa oparta na tablicy" << std::endl;
         std::cout << "3. Uruchom testy wydajnosci" << std::endl;
+        std::cout << "4. Uruchom testy skalowalnosci (duze rozmiary)" << std::endl;
+        std::cout << "5. Uruchom test kolejki w pamieci zewnetrznej" << std::endl;
+        std::cout << "6. Uruchom test zegarow (kolo czasowe vs kopiec)" << std::endl;
+        std::cout << "7. Uruchom test kolejki trwalej (dziennik operacji)" << std::endl;
+        std::cout << "8. Uruchom test zapisu w tle" << std::endl;
+        std::cout << "9. Ustaw liczbe watkow (aktualnie " << liczbaWatkow << ")" << std::endl;
+        std::cout << "10. Uruchom test budowy i eksportu rownoleglego" << std::endl;
+        std::cout << "11. Uruchom test harmonogramu zadan (work stealing)" << std::endl;
+        std::cout << "12. Uruchom test symulacji zdarzen (model hold)" << std::endl;
+        std::cout << "13. Uruchom test algorytmow grafowych (Dijkstra, Prim, A*)" << std::endl;
+        std::cout << "14. Uruchom test malych kolejek (bez alokacji)" << std::endl;
         std::cout << "0. Wyjscie" << std::endl;
         std::cout << "Wybierz opcje: ";
         std::cin >> wybor;
@@ -631,7 +2289,40 @@ int main() {
             wyswietlMenu(kolejkaTablicy, "Kolejka Priorytetowa Oparta na Tablicy");
             break;
         case 3:
-            uruchomTestyWydajnosci();
+            uruchomTestyWydajnosci(ziarnoTestow, "wyniki_wydajnosci");
+            break;
+        case 4:
+            uruchomTestySkalowalnosci();
+            break;
+        case 5:
+            uruchomTestPamieciZewnetrznej();
+            break;
+        case 6:
+            uruchomTestZegarow();
+            break;
+        case 7:
+            uruchomTestTrwalosci();
+            break;
+        case 8:
+            uruchomTestZapisuWTle();
+            break;
+        case 9:
+            ustawLiczbeWatkow();
+            break;
+        case 10:
+            uruchomTestRownoleglosci();
+            break;
+        case 11:
+            uruchomTestHarmonogramu();
+            break;
+        case 12:
+            uruchomTestSymulacji();
+            break;
+        case 13:
+            uruchomTestGrafow();
+            break;
+        case 14:
+            uruchomTestMalychKolejek();
             break;
         default:
             std::cout << "Nieprawidlowy wybor. Sprobuj ponownie." << std::endl;
@@ -0,0 +1,83 @@
+#ifndef PARALLEL_TASKS_H
+#define PARALLEL_TASKS_H
+
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <utility>
+
+//proste narzedzia rownoleglosci na std::thread (bez zaleznosci od std::execution/TBB)
+
+//wykonanie task(i) dla i z [0, tasks) na threads watkach (watek wolajacy tez pracuje)
+//zadania sa pobierane z licznika atomowego, wiec nierowne zadania sie wyrownuja
+template <typename Task>
+void parallelFor(std::size_t tasks, unsigned threads, const Task& task) {
+    if (threads <= 1 || tasks <= 1) {
+        for (std::size_t i = 0; i < tasks; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    unsigned workers = (unsigned)std::min<std::size_t>(threads, tasks);
+    std::atomic<std::size_t> next(0);
+    auto work = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < tasks; i = next.fetch_add(1)) {
+            task(i);
+        }
+    };
+
+    std::thread* pool = new std::thread[workers - 1];
+    for (unsigned t = 0; t + 1 < workers; t++) {
+        pool[t] = std::thread(work);
+    }
+    work();
+    for (unsigned t = 0; t + 1 < workers; t++) {
+        pool[t].join();
+    }
+    delete[] pool;
+}
+
+//sortowanie rownolegle: threads fragmentow sortowanych niezaleznie, potem rundy scalania parami
+//(scalania jednej rundy tez sa rownolegle); dla malych tablic zwykle std::sort
+template <typename Entry, typename Less>
+void parallelSort(Entry* data, std::size_t count, const Less& less, unsigned threads) {
+    const std::size_t MIN_PARALLEL = (std::size_t)1 << 15;
+    if (threads <= 1 || count < MIN_PARALLEL) {
+        std::sort(data, data + count, less);
+        return;
+    }
+
+    std::size_t chunks = threads;
+    std::size_t chunkSize = (count + chunks - 1) / chunks;
+    parallelFor(chunks, threads, [&](std::size_t c) {
+        std::size_t begin = std::min(count, c * chunkSize);
+        std::size_t end = std::min(count, begin + chunkSize);
+        std::sort(data + begin, data + end, less);
+    });
+
+    Entry* buffer = new Entry[count];
+    Entry* source = data;
+    Entry* target = buffer;
+    for (std::size_t width = chunkSize; width < count; width *= 2) {
+        std::size_t pairs = (count + 2 * width - 1) / (2 * width);
+        parallelFor(pairs, threads, [&](std::size_t p) {
+            std::size_t begin = p * 2 * width;
+            std::size_t middle = std::min(count, begin + width);
+            std::size_t end = std::min(count, begin + 2 * width);
+            std::merge(source + begin, source + middle, source + middle, source + end, target + begin, less);
+        });
+        std::swap(source, target);
+    }
+    if (source != data) {
+        parallelFor(chunks, threads, [&](std::size_t c) {
+            std::size_t begin = std::min(count, c * chunkSize);
+            std::size_t end = std::min(count, begin + chunkSize);
+            std::copy(source + begin, source + end, data + begin);
+        });
+    }
+    delete[] buffer;
+}
+
+#endif // PARALLEL_TASKS_H
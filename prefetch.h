@@ -0,0 +1,19 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+
+//programowe pobranie linii pamieci do cache (podpowiedz dla procesora, bez efektu na wynik)
+inline void prefetchRead(const void* address) {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_prefetch((const char*)address, _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+#endif // PREFETCH_H
@@ -0,0 +1,178 @@
+#ifndef PRIORITY_ORDER_H
+#define PRIORITY_ORDER_H
+
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+//porzadek priorytetow wspolny dla wszystkich kolejek
+//Compare dziala jak w std::priority_queue: std::less<Priority> daje kolejke "najwiekszy pierwszy",
+//std::greater<Priority> kolejke "najmniejszy pierwszy"
+//higher(compare, a, b) == true gdy priorytet a ma byc obsluzony przed priorytetem b
+template <typename Priority, typename Compare>
+struct PriorityOrder {
+    static constexpr bool higher(const Compare& compare, const Priority& a, const Priority& b) {
+        return compare(b, a);
+    }
+};
+
+//specjalizacje dla domyslnych porownan - kompilowane do zwyklego porownania bez wywolania funktora
+template <typename Priority>
+struct PriorityOrder<Priority, std::less<Priority> > {
+    static constexpr bool higher(const std::less<Priority>&, const Priority& a, const Priority& b) {
+        return b < a;
+    }
+};
+
+template <typename Priority>
+struct PriorityOrder<Priority, std::greater<Priority> > {
+    static constexpr bool higher(const std::greater<Priority>&, const Priority& a, const Priority& b) {
+        return b > a;
+    }
+};
+
+//polityka stabilnosci: StableOrder zachowuje kolejnosc FIFO przy rownych priorytetach,
+//UnstableOrder nie przechowuje czasu wstawienia i nie rozstrzyga remisow (mniejsze elementy)
+struct StableOrder {};
+struct UnstableOrder {};
+
+//element kolejki: priorytet, wartosc i (tylko w trybie stabilnym) czas wstawienia
+//konstruktory sa constexpr, wiec dla typow literalnych elementy moga powstawac w wyrazeniach stalych
+template <typename T, typename Priority, typename Stability>
+struct PriorityEntry;
+
+template <typename T, typename Priority>
+struct PriorityEntry<T, Priority, StableOrder> {
+    Priority priority;
+    T value;
+    unsigned long long insertTime;  //czas wstawienia do kolejki (dla FIFO)
+
+    constexpr PriorityEntry() : priority(), value(), insertTime(0) {}
+
+    constexpr PriorityEntry(const Priority& p, const T& v, unsigned long long time)
+        : priority(p), value(v), insertTime(time) {}
+
+    //przy rownych priorytetach wczesniej wstawiony element ma pierwszenstwo
+    static constexpr bool before(const PriorityEntry& a, const PriorityEntry& b) {
+        return a.insertTime < b.insertTime;
+    }
+
+    void printInsertTime(std::ostream& out) const {
+        out << ", Czas wstawienia: " << insertTime;
+    }
+};
+
+template <typename T, typename Priority>
+struct PriorityEntry<T, Priority, UnstableOrder> {
+    Priority priority;
+    T value;
+
+    constexpr PriorityEntry() : priority(), value() {}
+
+    constexpr PriorityEntry(const Priority& p, const T& v, unsigned long long)
+        : priority(p), value(v) {}
+
+    //bez czasu wstawienia remisy nie sa rozstrzygane
+    static constexpr bool before(const PriorityEntry&, const PriorityEntry&) {
+        return false;
+    }
+
+    void printInsertTime(std::ostream&) const {}
+};
+
+//globalne przesuniecie priorytetow (shiftAllPriorities, starzenie) - tylko dla typow arytmetycznych
+//kolejka przechowuje priorytet wzgledny: zapisany = efektywny - base, wiec zmiana priorytetu
+//wszystkich elementow o te sama wartosc to zmiana base w O(1), a porzadek kopca sie nie zmienia
+//base jest trzymane w przedziale [-limit(), limit()] (polowa zakresu typu): gdy przesuniecie by go
+//przekroczylo, tryShift zwraca false, a kolejka wlicza base i delta do zapisanych priorytetow w O(n)
+//i zeruje base (zamortyzowane - zdarza sie co najwyzej raz na limit() / |delta| przesuniec)
+//priorytety efektywne musza sie miescic w typie, zapisane sa wtedy w zakresie rowniez
+//przesuwac mozna tylko typy ze znakiem (dla typow bez znaku ujemne delta zawijaloby sie)
+template <typename Priority, bool Arithmetic = std::is_arithmetic<Priority>::value>
+struct PriorityOffset {
+    Priority base;
+
+    PriorityOffset() : base() {}
+
+    Priority toStored(const Priority& effective) const {
+        return effective - base;
+    }
+
+    Priority toEffective(const Priority& stored) const {
+        return stored + base;
+    }
+
+    static Priority limit() {
+        return std::numeric_limits<Priority>::max() / 2;
+    }
+
+    //przesuniecie o delta, o ile base zostaje w przedziale [-limit(), limit()] - inaczej false i bez zmian
+    //(|base| <= limit() i |delta| <= limit(), wiec samo dodawanie nie wychodzi poza zakres typu)
+    bool tryShift(const Priority& delta) {
+        static_assert(std::is_signed<Priority>::value,
+            "Przesuwanie priorytetow wymaga typu ze znakiem albo zmiennoprzecinkowego");
+        if (delta > limit() || delta < -limit()) {
+            return false;
+        }
+        Priority moved = base + delta;
+        if (moved > limit() || moved < -limit()) {
+            return false;
+        }
+        base = moved;
+        return true;
+    }
+
+    void reset() {
+        base = Priority();
+    }
+};
+
+//dla typow niearytmetycznych (np. napisow) priorytety sa przechowywane bez zmian, a shift nie istnieje
+template <typename Priority>
+struct PriorityOffset<Priority, false> {
+    const Priority& toStored(const Priority& effective) const {
+        return effective;
+    }
+
+    const Priority& toEffective(const Priority& stored) const {
+        return stored;
+    }
+
+    void reset() {}
+};
+
+//licznik wstawien - w trybie niestabilnym nie przechowuje zadnego stanu
+template <typename Stability>
+struct InsertClock;
+
+template <>
+struct InsertClock<StableOrder> {
+    unsigned long long counter;
+
+    constexpr InsertClock() : counter(0) {}
+
+    constexpr unsigned long long next() {
+        return counter++;
+    }
+
+    //rezerwacja count kolejnych czasow naraz (budowa hurtowa) - zwraca pierwszy z nich
+    constexpr unsigned long long reserve(unsigned long long count) {
+        unsigned long long first = counter;
+        counter += count;
+        return first;
+    }
+};
+
+template <>
+struct InsertClock<UnstableOrder> {
+    constexpr unsigned long long next() {
+        return 0;
+    }
+
+    constexpr unsigned long long reserve(unsigned long long) {
+        return 0;
+    }
+};
+
+#endif // PRIORITY_ORDER_H
@@ -0,0 +1,261 @@
+#ifndef PRIORITY_TASK_SCHEDULER_H
+#define PRIORITY_TASK_SCHEDULER_H
+
+#include <stdexcept>
+#include <cstddef>
+#include <climits>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include "heap_priority_queue.h"
+
+//harmonogram zadan z priorytetami dla puli watkow (work stealing)
+//- kazdy watek roboczy ma wlasna kolejke HeapPriorityQueue zadan chroniona wlasnym mutexem,
+//  zadania zglaszane z watku roboczego trafiaja do jego kolejki, a z zewnatrz - po kolei do watkow
+//- kazdy watek publikuje priorytet swojego najlepszego zadania (atomowo); maksimum z nich jest
+//  globalna wskazowka: gdy inny watek ma zadanie lepsze o wiecej niz inversionSlack od naszego,
+//  albo nasza kolejka jest pusta, kradniemy od niego paczke stealBatch najlepszych zadan
+//- inwersja priorytetu jest liczona, gdy wykonywane zadanie ma nizszy priorytet niz najlepsze
+//  zadanie opublikowane w tym momencie przez inny watek
+//wiekszy priorytet = wczesniejsze wykonanie (jak domyslnie w kolejkach), FIFO przy rownych
+class PriorityTaskScheduler {
+public:
+    typedef std::function<void()> Task;
+
+private:
+    static const int EMPTY = INT_MIN;    //opublikowany priorytet pustej kolejki
+    static const std::size_t MAX_STEAL_BATCH = 64;  //pojemnosc bufora kradziezy na stosie (steal)
+
+    struct Worker {
+        std::mutex lock;
+        HeapPriorityQueue<Task, int> queue;
+        std::atomic<int> topPriority;
+        std::thread thread;
+
+        Worker() : queue(64), topPriority(EMPTY) {}
+    };
+
+    //watek roboczy biezacego watku systemowego (nullptr poza pula)
+    struct CurrentWorker {
+        const PriorityTaskScheduler* scheduler;
+        std::size_t index;
+    };
+
+    static CurrentWorker& current() {
+        static thread_local CurrentWorker worker = { nullptr, 0 };
+        return worker;
+    }
+
+    Worker* workers;
+    std::size_t workerCount;
+    std::size_t stealBatch;
+    int inversionSlack;
+
+    std::atomic<bool> stopping;
+    std::atomic<std::size_t> nextWorker;     //rozdzial zadan zglaszanych z zewnatrz
+    std::atomic<unsigned long long> queued;  //zadania czekajace w kolejkach
+    std::atomic<unsigned long long> pending; //zadania zgloszone i jeszcze niezakonczone
+
+    std::mutex sleepLock;
+    std::condition_variable sleepCondition;
+    std::mutex idleLock;
+    std::condition_variable idleCondition;
+
+    std::atomic<unsigned long long> executed;
+    std::atomic<unsigned long long> stolen;
+    std::atomic<unsigned long long> steals;
+    std::atomic<unsigned long long> inversions;
+
+    //wolane pod blokada kolejki
+    static void publish(Worker& worker) {
+        worker.topPriority.store(worker.queue.isEmpty() ? EMPTY : worker.queue.findMaxPriority(),
+            std::memory_order_relaxed);
+    }
+
+    //najlepszy opublikowany priorytet innego watku i jego indeks (workerCount gdy wszystkie puste)
+    int bestOther(std::size_t self, std::size_t& victim) const {
+        int best = EMPTY;
+        victim = workerCount;
+        for (std::size_t w = 0; w < workerCount; w++) {
+            if (w == self) {
+                continue;
+            }
+            int top = workers[w].topPriority.load(std::memory_order_relaxed);
+            if (top > best) {
+                best = top;
+                victim = w;
+            }
+        }
+        return best;
+    }
+
+    //kradziez paczki najlepszych zadan ofiary do wlasnej kolejki
+    void steal(std::size_t self, std::size_t victim) {
+        Task batch[MAX_STEAL_BATCH];
+        int priorities[MAX_STEAL_BATCH];
+        std::size_t count = 0;
+        {
+            std::lock_guard<std::mutex> guard(workers[victim].lock);
+            Worker& source = workers[victim];
+            while (count < stealBatch && !source.queue.isEmpty()) {
+                priorities[count] = source.queue.findMaxPriority();
+                batch[count] = source.queue.extractMax();
+                count++;
+            }
+            publish(source);
+        }
+        if (count == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guard(workers[self].lock);
+            for (std::size_t i = 0; i < count; i++) {
+                workers[self].queue.insert(batch[i], priorities[i]);
+            }
+            publish(workers[self]);
+        }
+        steals.fetch_add(1, std::memory_order_relaxed);
+        stolen.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    bool takeTask(std::size_t self, Task& task) {
+        Worker& own = workers[self];
+        std::size_t victim;
+        int other = bestOther(self, victim);
+        int mine = own.topPriority.load(std::memory_order_relaxed);
+        if (victim != workerCount && (mine == EMPTY || (long long)other > (long long)mine + inversionSlack)) {
+            steal(self, victim);
+        }
+
+        int priority;
+        {
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (own.queue.isEmpty()) {
+                return false;
+            }
+            priority = own.queue.findMaxPriority();
+            task = own.queue.extractMax();
+            publish(own);
+        }
+        queued.fetch_sub(1, std::memory_order_relaxed);
+
+        if (bestOther(self, victim) > priority) {
+            inversions.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    void run(std::size_t self) {
+        current().scheduler = this;
+        current().index = self;
+
+        Task task;
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (takeTask(self, task)) {
+                task();
+                task = Task();
+                executed.fetch_add(1, std::memory_order_relaxed);
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> guard(idleLock);
+                    idleCondition.notify_all();
+                }
+                continue;
+            }
+
+            //brak pracy - krotki sen (budzi zgloszenie zadania, limit czasu chroni przed zgubionym sygnalem)
+            std::unique_lock<std::mutex> sleep(sleepLock);
+            sleepCondition.wait_for(sleep, std::chrono::milliseconds(1), [this]() {
+                return stopping.load(std::memory_order_acquire) || queued.load(std::memory_order_relaxed) > 0;
+            });
+        }
+    }
+
+public:
+    //batch - rozmiar paczki kradziezy, przycinany do przedzialu [1, MAX_STEAL_BATCH]: paczka przechodzi
+    //przez bufor na stosie, zeby kolejka ofiary byla zablokowana tylko na czas zdejmowania zadan
+    PriorityTaskScheduler(unsigned threads, std::size_t batch = 8, int slack = 0) :
+        workerCount(threads > 0 ? threads : 1),
+        stealBatch(batch == 0 ? 1 : (batch < MAX_STEAL_BATCH ? batch : MAX_STEAL_BATCH)), inversionSlack(slack),
+        stopping(false), nextWorker(0), queued(0), pending(0),
+        executed(0), stolen(0), steals(0), inversions(0) {
+        workers = new Worker[workerCount];
+        for (std::size_t w = 0; w < workerCount; w++) {
+            workers[w].thread = std::thread(&PriorityTaskScheduler::run, this, w);
+        }
+    }
+
+    //zatrzymanie puli - zadania, ktore nie zdazyly sie wykonac, przepadaja (najpierw waitIdle)
+    ~PriorityTaskScheduler() {
+        stopping.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            sleepCondition.notify_all();
+        }
+        for (std::size_t w = 0; w < workerCount; w++) {
+            workers[w].thread.join();
+        }
+        delete[] workers;
+    }
+
+    PriorityTaskScheduler(const PriorityTaskScheduler&) = delete;
+    PriorityTaskScheduler& operator=(const PriorityTaskScheduler&) = delete;
+
+    //zgloszenie zadania; z watku roboczego tej puli trafia do jego wlasnej kolejki
+    void submit(const Task& task, int priority) {
+        if (priority == EMPTY) {
+            throw std::runtime_error("Priorytet INT_MIN jest zarezerwowany");
+        }
+
+        std::size_t target;
+        if (current().scheduler == this) {
+            target = current().index;
+        }
+        else {
+            target = nextWorker.fetch_add(1, std::memory_order_relaxed) % workerCount;
+        }
+
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> guard(workers[target].lock);
+            workers[target].queue.insert(task, priority);
+            publish(workers[target]);
+        }
+        if (queued.fetch_add(1, std::memory_order_relaxed) == 0) {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            sleepCondition.notify_all();
+        }
+    }
+
+    //czekanie, az wszystkie zgloszone zadania (rowniez zgloszone przez inne zadania) sie zakoncza
+    void waitIdle() {
+        std::unique_lock<std::mutex> guard(idleLock);
+        idleCondition.wait(guard, [this]() {
+            return pending.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    std::size_t returnWorkerCount() const {
+        return workerCount;
+    }
+
+    unsigned long long returnExecuted() const {
+        return executed.load();
+    }
+
+    unsigned long long returnStolen() const {
+        return stolen.load();
+    }
+
+    unsigned long long returnSteals() const {
+        return steals.load();
+    }
+
+    unsigned long long returnInversions() const {
+        return inversions.load();
+    }
+};
+
+#endif // PRIORITY_TASK_SCHEDULER_H
@@ -0,0 +1,470 @@
+#ifndef SEQUENCE_HEAP_H
+#define SEQUENCE_HEAP_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include "priority_order.h"
+#include "heap_sift.h"
+
+//kolejka priorytetowa typu sequence heap (Sanders) - uproszczona wersja w pamieci
+//- maly kopiec wstawien (insertionCapacity elementow, miesci sie w cache)
+//- bufor usuwania: posortowane deletionCapacity najlepszych elementow ze wszystkich sekwencji
+//- grupy posortowanych sekwencji: pelny kopiec wstawien staje sie sekwencja w grupie 0,
+//  a gdy grupa ma mergeFactor sekwencji, sa one scalane (k-way) w jedna sekwencje grupy wyzej
+//wiekszosc operacji dotyka tylko kopca wstawien i bufora usuwania, scalanie jest sekwencyjne
+//brak modifyKey/increaseKey/decreaseKey; getPriority dziala w O(n)
+template <typename T, typename Priority = int, typename Compare = std::less<Priority>, typename Stability = StableOrder>
+class SequenceHeap {
+private:
+    typedef PriorityOrder<Priority, Compare> Order;
+    typedef PriorityEntry<T, Priority, Stability> Entry;
+
+    static const std::size_t MAX_GROUPS = 16;
+
+    //posortowana sekwencja (najlepszy element na poczatku), elementy [begin, end) sa jeszcze w kolejce
+    struct Sequence {
+        Entry* data;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct Group {
+        Sequence* sequences;
+        std::size_t count;
+    };
+
+    //czolo sekwencji w kopcu scalajacym
+    struct MergeNode {
+        Entry entry;
+        std::size_t group;
+        std::size_t sequence;
+    };
+
+    struct EntryPrecedes {
+        const SequenceHeap* queue;
+
+        bool operator()(const Entry& a, const Entry& b) const {
+            return queue->precedes(a, b);
+        }
+    };
+
+    struct NodePrecedes {
+        const SequenceHeap* queue;
+
+        bool operator()(const MergeNode& a, const MergeNode& b) const {
+            return queue->precedes(a.entry, b.entry);
+        }
+    };
+
+    Entry* insertionHeap;
+    std::size_t insertionCapacity;
+    std::size_t insertionSize;
+
+    Entry* deletionBuffer;          //posortowany od najgorszego, najlepszy element na koncu
+    std::size_t deletionCapacity;
+    std::size_t deletionSize;
+
+    Group groups[MAX_GROUPS];
+    std::size_t groupCount;
+    std::size_t mergeFactor;        //maksymalna liczba sekwencji w grupie
+
+    MergeNode* mergeNodes;          //kopiec roboczy do scalania (mergeFactor * MAX_GROUPS miejsc)
+
+    std::size_t size;
+    InsertClock<Stability> insertCounter;
+    Compare compare;
+
+    bool precedes(const Entry& a, const Entry& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return Entry::before(a, b);
+    }
+
+    EntryPrecedes entryPrecedes() const {
+        EntryPrecedes fn = { this };
+        return fn;
+    }
+
+    NodePrecedes nodePrecedes() const {
+        NodePrecedes fn = { this };
+        return fn;
+    }
+
+    void allocate() {
+        insertionHeap = new Entry[insertionCapacity];
+        deletionBuffer = new Entry[deletionCapacity];
+        mergeNodes = new MergeNode[mergeFactor * MAX_GROUPS];
+        for (std::size_t g = 0; g < MAX_GROUPS; g++) {
+            groups[g].sequences = new Sequence[mergeFactor];
+            groups[g].count = 0;
+        }
+    }
+
+    void release() {
+        for (std::size_t g = 0; g < MAX_GROUPS; g++) {
+            for (std::size_t s = 0; s < groups[g].count; s++) {
+                delete[] groups[g].sequences[s].data;
+            }
+            delete[] groups[g].sequences;
+        }
+        delete[] insertionHeap;
+        delete[] deletionBuffer;
+        delete[] mergeNodes;
+    }
+
+    void copyFrom(const SequenceHeap& other) {
+        allocate();
+        for (std::size_t i = 0; i < insertionSize; i++) {
+            insertionHeap[i] = other.insertionHeap[i];
+        }
+        for (std::size_t i = 0; i < deletionSize; i++) {
+            deletionBuffer[i] = other.deletionBuffer[i];
+        }
+        for (std::size_t g = 0; g < groupCount; g++) {
+            groups[g].count = other.groups[g].count;
+            for (std::size_t s = 0; s < other.groups[g].count; s++) {
+                const Sequence& source = other.groups[g].sequences[s];
+                Sequence& target = groups[g].sequences[s];
+                target.begin = 0;
+                target.end = source.end - source.begin;
+                target.data = new Entry[target.end];
+                for (std::size_t i = 0; i < target.end; i++) {
+                    target.data[i] = source.data[source.begin + i];
+                }
+            }
+        }
+    }
+
+    //usun sekwencje z grupy (ostatnia wskakuje na jej miejsce)
+    void removeSequence(std::size_t g, std::size_t s) {
+        delete[] groups[g].sequences[s].data;
+        groups[g].sequences[s] = groups[g].sequences[groups[g].count - 1];
+        groups[g].count--;
+    }
+
+    //dodaj sekwencje do grupy g, scalajac pelna grupe w jedna sekwencje grupy wyzej
+    void addSequence(std::size_t g, const Sequence& sequence) {
+        if (g >= MAX_GROUPS) {
+            throw std::runtime_error("Przekroczono liczbe grup sequence heap");
+        }
+        if (g >= groupCount) {
+            groupCount = g + 1;
+        }
+        if (groups[g].count == mergeFactor) {
+            addSequence(g + 1, mergeGroup(g));
+        }
+        groups[g].sequences[groups[g].count++] = sequence;
+    }
+
+    //scal wszystkie sekwencje grupy g w jedna (k-way merge)
+    Sequence mergeGroup(std::size_t g) {
+        std::size_t total = 0;
+        std::size_t nodes = 0;
+        for (std::size_t s = 0; s < groups[g].count; s++) {
+            Sequence& sequence = groups[g].sequences[s];
+            total += sequence.end - sequence.begin;
+            MergeNode node;
+            node.entry = sequence.data[sequence.begin];
+            node.group = g;
+            node.sequence = s;
+            siftUpHole(mergeNodes, nodes, node, nodePrecedes());
+            nodes++;
+        }
+
+        Sequence merged;
+        merged.data = new Entry[total];
+        merged.begin = 0;
+        merged.end = total;
+
+        for (std::size_t i = 0; i < total; i++) {
+            Sequence& source = groups[g].sequences[mergeNodes[0].sequence];
+            merged.data[i] = mergeNodes[0].entry;
+            source.begin++;
+            if (source.begin < source.end) {
+                MergeNode node = mergeNodes[0];
+                node.entry = source.data[source.begin];
+                siftDownHole(mergeNodes, nodes, 0, node, nodePrecedes());
+            }
+            else {
+                popRootBottomUp(mergeNodes, nodes, nodePrecedes());
+                nodes--;
+            }
+        }
+
+        for (std::size_t s = 0; s < groups[g].count; s++) {
+            delete[] groups[g].sequences[s].data;
+        }
+        groups[g].count = 0;
+        return merged;
+    }
+
+    //przenies pelny kopiec wstawien (razem z buforem usuwania) do grupy 0 jako nowa sekwencje
+    void flushInsertionHeap() {
+        std::size_t total = insertionSize + deletionSize;
+        Sequence sequence;
+        sequence.data = new Entry[total];
+        sequence.begin = 0;
+        sequence.end = total;
+
+        for (std::size_t i = 0; i < insertionSize; i++) {
+            sequence.data[i] = insertionHeap[i];
+        }
+        for (std::size_t i = 0; i < deletionSize; i++) {
+            sequence.data[insertionSize + i] = deletionBuffer[i];
+        }
+        std::sort(sequence.data, sequence.data + total, entryPrecedes());
+
+        insertionSize = 0;
+        deletionSize = 0;
+        addSequence(0, sequence);
+        refillDeletionBuffer();
+    }
+
+    //uzupelnij bufor usuwania najlepszymi elementami wszystkich sekwencji
+    void refillDeletionBuffer() {
+        std::size_t nodes = 0;
+        for (std::size_t g = 0; g < groupCount; g++) {
+            for (std::size_t s = 0; s < groups[g].count; s++) {
+                Sequence& sequence = groups[g].sequences[s];
+                MergeNode node;
+                node.entry = sequence.data[sequence.begin];
+                node.group = g;
+                node.sequence = s;
+                siftUpHole(mergeNodes, nodes, node, nodePrecedes());
+                nodes++;
+            }
+        }
+
+        //pobieramy najlepsze elementy, bufor zapisujemy od konca (najlepszy na koncu)
+        std::size_t taken = 0;
+        while (taken < deletionCapacity && nodes > 0) {
+            deletionBuffer[deletionCapacity - 1 - taken] = mergeNodes[0].entry;
+            taken++;
+
+            Sequence& source = groups[mergeNodes[0].group].sequences[mergeNodes[0].sequence];
+            source.begin++;
+            if (source.begin < source.end) {
+                MergeNode node = mergeNodes[0];
+                node.entry = source.data[source.begin];
+                siftDownHole(mergeNodes, nodes, 0, node, nodePrecedes());
+            }
+            else {
+                popRootBottomUp(mergeNodes, nodes, nodePrecedes());
+                nodes--;
+            }
+        }
+
+        //przesun pobrane elementy na poczatek bufora
+        for (std::size_t i = 0; i < taken; i++) {
+            deletionBuffer[i] = deletionBuffer[deletionCapacity - taken + i];
+        }
+        deletionSize = taken;
+
+        //usun wyczerpane sekwencje
+        for (std::size_t g = 0; g < groupCount; g++) {
+            std::size_t s = 0;
+            while (s < groups[g].count) {
+                if (groups[g].sequences[s].begin == groups[g].sequences[s].end) {
+                    removeSequence(g, s);
+                }
+                else {
+                    s++;
+                }
+            }
+        }
+    }
+
+    //czy najlepszy element jest w kopcu wstawien (a nie w buforze usuwania)
+    bool topInInsertionHeap() const {
+        if (deletionSize == 0) {
+            return true;
+        }
+        if (insertionSize == 0) {
+            return false;
+        }
+        return precedes(insertionHeap[0], deletionBuffer[deletionSize - 1]);
+    }
+
+    const Entry* findEntry(const T& element) const {
+        for (std::size_t i = 0; i < insertionSize; i++) {
+            if (insertionHeap[i].value == element) {
+                return &insertionHeap[i];
+            }
+        }
+        for (std::size_t i = 0; i < deletionSize; i++) {
+            if (deletionBuffer[i].value == element) {
+                return &deletionBuffer[i];
+            }
+        }
+        for (std::size_t g = 0; g < groupCount; g++) {
+            for (std::size_t s = 0; s < groups[g].count; s++) {
+                const Sequence& sequence = groups[g].sequences[s];
+                for (std::size_t i = sequence.begin; i < sequence.end; i++) {
+                    if (sequence.data[i].value == element) {
+                        return &sequence.data[i];
+                    }
+                }
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    //insertionCapacity - rozmiar kopca wstawien, deletionCapacity - rozmiar bufora usuwania,
+    //mergeFactor - liczba sekwencji w grupie scalanych naraz
+    SequenceHeap(std::size_t insertionCapacityValue = 512, std::size_t deletionCapacityValue = 64,
+        std::size_t mergeFactorValue = 16, const Compare& comparator = Compare()) :
+        insertionCapacity(std::max<std::size_t>(insertionCapacityValue, 1)), insertionSize(0),
+        deletionCapacity(std::max<std::size_t>(deletionCapacityValue, 1)), deletionSize(0),
+        groupCount(0), mergeFactor(std::max<std::size_t>(mergeFactorValue, 2)), size(0), compare(comparator) {
+        allocate();
+    }
+
+    ~SequenceHeap() {
+        release();
+    }
+
+    SequenceHeap(const SequenceHeap& other) :
+        insertionCapacity(other.insertionCapacity), insertionSize(other.insertionSize),
+        deletionCapacity(other.deletionCapacity), deletionSize(other.deletionSize),
+        groupCount(other.groupCount), mergeFactor(other.mergeFactor), size(other.size),
+        insertCounter(other.insertCounter), compare(other.compare) {
+        copyFrom(other);
+    }
+
+    SequenceHeap& operator=(const SequenceHeap& other) {
+        if (this != &other) {
+            release();
+
+            insertionCapacity = other.insertionCapacity;
+            insertionSize = other.insertionSize;
+            deletionCapacity = other.deletionCapacity;
+            deletionSize = other.deletionSize;
+            groupCount = other.groupCount;
+            mergeFactor = other.mergeFactor;
+            size = other.size;
+            insertCounter = other.insertCounter;
+            compare = other.compare;
+
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    //dodaj element i jego priorytet
+    void insert(const T& element, const Priority& priority) {
+        if (insertionSize == insertionCapacity) {
+            flushInsertionHeap();
+        }
+        siftUpHole(insertionHeap, insertionSize, Entry(priority, element, insertCounter.next()), entryPrecedes());
+        insertionSize++;
+        size++;
+    }
+
+    //usun element z najwiekszym priorytetem
+    T extractMax() {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+
+        size--;
+        if (topInInsertionHeap()) {
+            T maxElement = insertionHeap[0].value;
+            popRootBottomUp(insertionHeap, insertionSize, entryPrecedes());
+            insertionSize--;
+            return maxElement;
+        }
+
+        T maxElement = deletionBuffer[--deletionSize].value;
+        if (deletionSize == 0) {
+            refillDeletionBuffer();
+        }
+        return maxElement;
+    }
+
+    T findMax() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return topInInsertionHeap() ? insertionHeap[0].value : deletionBuffer[deletionSize - 1].value;
+    }
+
+    //priorytet elementu (przeszukanie wszystkich struktur - O(n))
+    Priority getPriority(const T& element) const {
+        const Entry* entry = findEntry(element);
+        if (entry == nullptr) {
+            throw std::runtime_error("Nie znaleziono elementu");
+        }
+        return entry->priority;
+    }
+
+    std::size_t returnSize() const {
+        return size;
+    }
+
+    //liczba zaalokowanych miejsc na elementy
+    std::size_t returnCapacity() const {
+        std::size_t capacity = insertionCapacity + deletionCapacity;
+        for (std::size_t g = 0; g < groupCount; g++) {
+            for (std::size_t s = 0; s < groups[g].count; s++) {
+                capacity += groups[g].sequences[s].end;
+            }
+        }
+        return capacity;
+    }
+
+    //pamiec zajmowana przez elementy i struktury pomocnicze (w bajtach)
+    std::size_t memoryUsage() const {
+        return returnCapacity() * sizeof(Entry)
+            + mergeFactor * MAX_GROUPS * (sizeof(MergeNode) + sizeof(Sequence));
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    void clear() {
+        for (std::size_t g = 0; g < groupCount; g++) {
+            while (groups[g].count > 0) {
+                removeSequence(g, groups[g].count - 1);
+            }
+        }
+        groupCount = 0;
+        insertionSize = 0;
+        deletionSize = 0;
+        size = 0;
+    }
+
+    void print() const {
+        std::cout << "Kolejka Priorytetowa (Sequence heap): " << std::endl;
+        for (std::size_t i = 0; i < insertionSize; i++) {
+            std::cout << "Priorytet: " << insertionHeap[i].priority << ", Element: " << insertionHeap[i].value;
+            insertionHeap[i].printInsertTime(std::cout);
+            std::cout << std::endl;
+        }
+        for (std::size_t i = deletionSize; i > 0; i--) {
+            std::cout << "Priorytet: " << deletionBuffer[i - 1].priority << ", Element: " << deletionBuffer[i - 1].value;
+            deletionBuffer[i - 1].printInsertTime(std::cout);
+            std::cout << std::endl;
+        }
+        for (std::size_t g = 0; g < groupCount; g++) {
+            for (std::size_t s = 0; s < groups[g].count; s++) {
+                const Sequence& sequence = groups[g].sequences[s];
+                for (std::size_t i = sequence.begin; i < sequence.end; i++) {
+                    std::cout << "Priorytet: " << sequence.data[i].priority << ", Element: " << sequence.data[i].value;
+                    sequence.data[i].printInsertTime(std::cout);
+                    std::cout << std::endl;
+                }
+            }
+        }
+    }
+};
+
+#endif // SEQUENCE_HEAP_H
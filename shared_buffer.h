@@ -0,0 +1,364 @@
+#ifndef SHARED_BUFFER_H
+#define SHARED_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include "priority_order.h"
+
+//leniwa kopia pierwszych count elementow tablicy kolejki, kopiowana stronami po PAGE elementow
+//(copy-before-write): kolejka dalej pisze w swojej tablicy, a przed zmiana elementu ze strony,
+//ktorej kopia jeszcze nie ma, kopiuje te jedna strone (preserve) - koszt pierwszego zapisu po
+//migawce nie zalezy od rozmiaru kolejki; czytelnik (np. watek zapisu) kopiuje pozostale strony
+//stan strony: LIVE (tylko w tablicy kolejki), BUSY (ktos ja wlasnie kopiuje), SAVED (kopia gotowa)
+//o strone LIVE rywalizuja kolejka i czytelnicy przez compare_exchange, przegrany czeka na SAVED
+//tablica kolejki musi zyc, dopoki sa strony LIVE - pilnuje tego SharedBuffer (preserveAll)
+template <typename Entry>
+class PagedCopy {
+public:
+    static const std::size_t PAGE = 1024;   //elementy na strone
+
+private:
+    enum PageState { LIVE, BUSY, SAVED };
+
+    struct State {
+        std::atomic<std::size_t> references;
+        const Entry* source;    //tablica kolejki
+        std::size_t count;
+        std::size_t pageCount;
+        std::atomic<unsigned char>* states;
+        Entry** pages;
+        std::atomic<std::size_t> remaining;     //strony jeszcze nie skopiowane
+    };
+
+    State* state;
+
+    void release() {
+        if (state != nullptr && state->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            for (std::size_t p = 0; p < state->pageCount; p++) {
+                delete[] state->pages[p];
+            }
+            delete[] state->pages;
+            delete[] state->states;
+            delete state;
+        }
+        state = nullptr;
+    }
+
+    //zapewnienie kopii strony: kopiuje ten, kto przejmie strone LIVE, pozostali czekaja
+    void savePage(std::size_t page) const {
+        std::atomic<unsigned char>& pageState = state->states[page];
+        if (pageState.load(std::memory_order_acquire) == SAVED) {
+            return;
+        }
+
+        unsigned char expected = LIVE;
+        if (pageState.compare_exchange_strong(expected, BUSY, std::memory_order_acq_rel)) {
+            std::size_t begin = page * PAGE;
+            std::size_t end = std::min(state->count, begin + PAGE);
+            try {
+                Entry* copy = new Entry[end - begin];
+                std::copy(state->source + begin, state->source + end, copy);
+                state->pages[page] = copy;
+            }
+            catch (...) {
+                pageState.store(LIVE, std::memory_order_release);
+                throw;
+            }
+            pageState.store(SAVED, std::memory_order_release);
+            state->remaining.fetch_sub(1, std::memory_order_acq_rel);
+            return;
+        }
+        while (pageState.load(std::memory_order_acquire) != SAVED) {
+            std::this_thread::yield();
+        }
+    }
+
+public:
+    PagedCopy() : state(nullptr) {}
+
+    //O(count / PAGE) - tylko tablice stanow i wskaznikow stron, bez kopiowania elementow
+    PagedCopy(const Entry* source, std::size_t count) : state(new State) {
+        state->references.store(1, std::memory_order_relaxed);
+        state->source = source;
+        state->count = count;
+        state->pageCount = (count + PAGE - 1) / PAGE;
+        state->states = nullptr;
+        state->pages = nullptr;
+        try {
+            state->states = new std::atomic<unsigned char>[state->pageCount];
+            state->pages = new Entry*[state->pageCount];
+        }
+        catch (...) {
+            delete[] state->states;
+            delete state;
+            throw;
+        }
+        for (std::size_t p = 0; p < state->pageCount; p++) {
+            state->states[p].store(LIVE, std::memory_order_relaxed);
+            state->pages[p] = nullptr;
+        }
+        state->remaining.store(state->pageCount, std::memory_order_release);
+    }
+
+    PagedCopy(const PagedCopy& other) : state(other.state) {
+        if (state != nullptr) {
+            state->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    PagedCopy& operator=(const PagedCopy& other) {
+        if (state != other.state) {
+            if (other.state != nullptr) {
+                other.state->references.fetch_add(1, std::memory_order_relaxed);
+            }
+            release();
+            state = other.state;
+        }
+        return *this;
+    }
+
+    ~PagedCopy() {
+        release();
+    }
+
+    bool isActive() const {
+        return state != nullptr;
+    }
+
+    std::size_t size() const {
+        return state != nullptr ? state->count : 0;
+    }
+
+    //czy wszystkie strony maja juz kopie (tablica kolejki nie jest dalej potrzebna)
+    bool isComplete() const {
+        return state == nullptr || state->remaining.load(std::memory_order_acquire) == 0;
+    }
+
+    //wolane przez kolejke przed zmiana elementu index jej tablicy
+    void preserve(std::size_t index) const {
+        if (index < state->count) {
+            savePage(index / PAGE);
+        }
+    }
+
+    void preserveAll() const {
+        if (state == nullptr) {
+            return;
+        }
+        for (std::size_t p = 0; p < state->pageCount && !isComplete(); p++) {
+            savePage(p);
+        }
+    }
+
+    //kopia elementow [begin, end) do target - mozna wolac rownolegle z kilku watkow
+    void copyTo(std::size_t begin, std::size_t end, Entry* target) const {
+        while (begin < end) {
+            std::size_t page = begin / PAGE;
+            std::size_t pageEnd = std::min(end, (page + 1) * PAGE);
+            savePage(page);
+            const Entry* saved = state->pages[page] + (begin - page * PAGE);
+            target = std::copy(saved, saved + (pageEnd - begin), target);
+            begin = pageEnd;
+        }
+    }
+};
+
+//wspoldzielona tablica elementow z licznikiem referencji (copy-on-write)
+//kopiowanie bufora tylko zwieksza licznik - O(1); strona, ktora chce pisac, wola detach()
+//i dostaje wlasna kopie tylko wtedy, gdy tablica jest wspoldzielona
+//migawki nie wspoldziela tablicy, tylko dostaja leniwa kopie stronami (pagedCopy): zapis wola
+//wczesniej beforeWrite, ktore kopiuje do migawki jedynie zmieniana strone; zanim bufor zwolni albo
+//przeniesie tablice, dokopiowuje brakujace strony (koszt tej operacji i tak jest O(n))
+//licznik jest atomowy, wiec migawke mozna zwolnic w innym watku niz kolejka; samo kopiowanie
+//(tworzenie migawki) musi odbywac sie w watku, ktory modyfikuje kolejke
+template <typename Entry>
+class SharedBuffer {
+private:
+    struct Block {
+        std::atomic<std::size_t> references;
+        std::size_t capacity;
+        Entry* data;
+    };
+
+    Block* block;
+    mutable PagedCopy<Entry> pending;   //ostatnia migawka, ktora moze jeszcze czytac te tablice
+
+    static Block* allocate(std::size_t capacity) {
+        Block* newBlock = new Block;
+        newBlock->references.store(1, std::memory_order_relaxed);
+        newBlock->capacity = capacity;
+        try {
+            newBlock->data = new Entry[capacity];
+        }
+        catch (...) {
+            delete newBlock;
+            throw;
+        }
+        return newBlock;
+    }
+
+    //migawka dostaje brakujace strony, zanim tablica zostanie zwolniona albo przeniesiona
+    void finishPendingCopy() const {
+        if (pending.isActive()) {
+            pending.preserveAll();
+            pending = PagedCopy<Entry>();
+        }
+    }
+
+    void release() {
+        finishPendingCopy();
+        if (block->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete[] block->data;
+            delete block;
+        }
+    }
+
+public:
+    explicit SharedBuffer(std::size_t capacity) : block(allocate(capacity)) {}
+
+    //kopia bufora nie przejmuje migawki - pisze dopiero po detach(), czyli we wlasnej tablicy
+    SharedBuffer(const SharedBuffer& other) : block(other.block) {
+        block->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SharedBuffer& operator=(const SharedBuffer& other) {
+        if (block != other.block) {
+            other.block->references.fetch_add(1, std::memory_order_relaxed);
+            release();
+            block = other.block;
+        }
+        return *this;
+    }
+
+    ~SharedBuffer() {
+        release();
+    }
+
+    Entry* data() const {
+        return block->data;
+    }
+
+    std::size_t capacity() const {
+        return block->capacity;
+    }
+
+    //czy tablice widzi jeszcze inna kopia kolejki lub migawka
+    bool isShared() const {
+        return block->references.load(std::memory_order_acquire) > 1;
+    }
+
+    //leniwa migawka pierwszych count elementow - O(count / PAGE) zamiast O(count)
+    //poprzednia migawka, ktora jeszcze kopiuje strony, jest wczesniej dokopiowana (O(n))
+    PagedCopy<Entry> pagedCopy(std::size_t count) const {
+        finishPendingCopy();
+        pending = PagedCopy<Entry>(block->data, count);
+        return pending;
+    }
+
+    //wolane przed zmiana elementu index (zapisem albo przeniesieniem z niego)
+    void beforeWrite(std::size_t index) const {
+        if (pending.isActive()) {
+            pending.preserve(index);
+        }
+    }
+
+    //nowa wlasna tablica o pojemnosci newCapacity z pierwszymi count elementami
+    //(przenoszonymi, gdy stara tablica nie jest wspoldzielona, w przeciwnym razie kopiowanymi)
+    void reallocate(std::size_t count, std::size_t newCapacity) {
+        finishPendingCopy();
+        Block* newBlock = allocate(newCapacity);
+        if (isShared()) {
+            for (std::size_t i = 0; i < count; i++) {
+                newBlock->data[i] = block->data[i];
+            }
+        }
+        else {
+            for (std::size_t i = 0; i < count; i++) {
+                newBlock->data[i] = std::move(block->data[i]);
+            }
+        }
+        release();
+        block = newBlock;
+    }
+
+    //zapewnienie wylacznosci przed zapisem - true gdy trzeba bylo skopiowac count elementow
+    //(migawka, ktora ma juz wszystkie strony, przestaje byc sledzona)
+    bool detach(std::size_t count) {
+        if (pending.isComplete()) {
+            pending = PagedCopy<Entry>();
+        }
+        if (!isShared()) {
+            return false;
+        }
+        reallocate(count, capacity());
+        return true;
+    }
+};
+
+//niezmienna migawka zawartosci kolejki (kolejnosc tablicy, nie kolejnosc priorytetow)
+//trzyma leniwa kopie stronami (PagedCopy), wiec kolejka moze dalej dzialac - zapis w kolejce
+//kopiuje do migawki tylko strone, ktora zmienia; czytanie migawki (copyTo) nie blokuje kolejki
+template <typename Entry, typename Priority, typename Compare>
+class QueueSnapshot {
+private:
+    typedef PriorityOrder<Priority, Compare> Order;
+
+    PagedCopy<Entry> pages;
+    Compare compare;
+    PriorityOffset<Priority> offset;    //przesuniecie priorytetow kolejki w chwili migawki
+
+public:
+    typedef Entry value_type;
+
+    //funktor porownania do sortowania elementow migawki (np. std::sort)
+    struct Precedes {
+        const QueueSnapshot* snapshot;
+
+        bool operator()(const Entry& a, const Entry& b) const {
+            return snapshot->precedes(a, b);
+        }
+    };
+
+    QueueSnapshot(const PagedCopy<Entry>& copy, const Compare& comparator,
+        const PriorityOffset<Priority>& priorityOffset = PriorityOffset<Priority>()) :
+        pages(copy), compare(comparator), offset(priorityOffset) {}
+
+    //kopia elementow [begin, end) do target - rownolegle wywolania dla rozlacznych zakresow sa dozwolone
+    void copyTo(std::size_t begin, std::size_t end, Entry* target) const {
+        pages.copyTo(begin, end, target);
+    }
+
+    std::size_t size() const {
+        return pages.size();
+    }
+
+    bool isEmpty() const {
+        return pages.size() == 0;
+    }
+
+    //priorytet elementu widziany przez kolejke (z przesunieciem shiftAllPriorities)
+    Priority priorityOf(const Entry& entry) const {
+        return offset.toEffective(entry.priority);
+    }
+
+    //ten sam porzadek co w kolejce: wyzszy priorytet, przy rownych wczesniejszy czas wstawienia
+    bool precedes(const Entry& a, const Entry& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return Entry::before(a, b);
+    }
+
+    Precedes precedesFn() const {
+        Precedes fn = { this };
+        return fn;
+    }
+};
+
+#endif // SHARED_BUFFER_H
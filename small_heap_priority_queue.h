@@ -0,0 +1,292 @@
+#ifndef SMALL_HEAP_PRIORITY_QUEUE_H
+#define SMALL_HEAP_PRIORITY_QUEUE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <array>
+#include <utility>
+#include "priority_order.h"
+#include "heap_sift.h"
+
+//kolejka priorytetowa na kopcu z buforem wewnatrz obiektu (small buffer optimization)
+//pierwsze InlineCapacity elementow miesci sie w tablicy std::array w obiekcie - mala kolejka
+//nie alokuje niczego; po przekroczeniu kopiec przenosi sie do tablicy na stercie (podwajanie),
+//a po oproznieniu do InlineCapacity elementow wraca do bufora wewnetrznego
+//kopia jest pelna kopia (bez wspoldzielenia jak w HeapPriorityQueue) - dla malych kolejek tansza
+template <typename T, std::size_t InlineCapacity = 32, typename Priority = int, typename Compare = std::less<Priority>,
+    typename Stability = StableOrder>
+class SmallHeapPriorityQueue {
+    static_assert(InlineCapacity > 0, "Pojemnosc bufora musi byc dodatnia");
+
+private:
+    typedef PriorityOrder<Priority, Compare> Order;
+    typedef PriorityEntry<T, Priority, Stability> HeapElement;
+
+    std::array<HeapElement, InlineCapacity> inlineHeap;   //bufor wewnatrz obiektu
+    HeapElement* heap;       //inlineHeap.data() albo tablica na stercie
+    std::size_t capacity;
+    std::size_t size;
+    InsertClock<Stability> insertCounter;
+    Compare compare;
+
+    bool precedes(const HeapElement& a, const HeapElement& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return HeapElement::before(a, b);
+    }
+
+    struct Precedes {
+        const SmallHeapPriorityQueue* queue;
+
+        bool operator()(const HeapElement& a, const HeapElement& b) const {
+            return queue->precedes(a, b);
+        }
+    };
+
+    Precedes precedesFn() const {
+        Precedes fn = { this };
+        return fn;
+    }
+
+    bool isInline() const {
+        return heap == inlineHeap.data();
+    }
+
+    void release() {
+        if (!isInline()) {
+            delete[] heap;
+        }
+    }
+
+    //przeniesienie kopca do tablicy o pojemnosci newCapacity (bufor wewnetrzny, gdy sie miesci)
+    void resize(std::size_t newCapacity) {
+        HeapElement* newHeap;
+        if (newCapacity <= InlineCapacity) {
+            if (isInline()) {
+                return;
+            }
+            newHeap = inlineHeap.data();
+            newCapacity = InlineCapacity;
+        }
+        else {
+            newHeap = new HeapElement[newCapacity];
+        }
+        for (std::size_t i = 0; i < size; i++) {
+            newHeap[i] = std::move(heap[i]);
+        }
+        release();
+        heap = newHeap;
+        capacity = newCapacity;
+    }
+
+    //kopia zawartosci innej kolejki do pustej kolejki w buforze wewnetrznym
+    void copyFrom(const SmallHeapPriorityQueue& other) {
+        if (other.capacity > InlineCapacity) {
+            heap = new HeapElement[other.capacity];
+            capacity = other.capacity;
+        }
+        for (std::size_t i = 0; i < other.size; i++) {
+            heap[i] = other.heap[i];
+        }
+        size = other.size;
+    }
+
+    void heapifyUp(std::size_t index) {
+        siftUpHole(heap, index, std::move(heap[index]), precedesFn());
+    }
+
+    //prefetch tylko dla kopca na stercie - bufor wewnetrzny to kilka linii cache
+    void heapifyDown(std::size_t index) {
+        if (isInline()) {
+            siftDownHole<false>(heap, size, index, std::move(heap[index]), precedesFn());
+        }
+        else {
+            siftDownHole(heap, size, index, std::move(heap[index]), precedesFn());
+        }
+    }
+
+    static const std::size_t notFound = (std::size_t)-1;
+
+    std::size_t findElementIndex(const T& element) const {
+        for (std::size_t i = 0; i < size; i++) {
+            if (heap[i].value == element) {
+                return i;
+            }
+        }
+        return notFound;
+    }
+
+public:
+    SmallHeapPriorityQueue(const Compare& comparator = Compare()) :
+        heap(inlineHeap.data()), capacity(InlineCapacity), size(0), compare(comparator) {}
+
+    ~SmallHeapPriorityQueue() {
+        release();
+    }
+
+    SmallHeapPriorityQueue(const SmallHeapPriorityQueue& other) :
+        heap(inlineHeap.data()), capacity(InlineCapacity), size(0),
+        insertCounter(other.insertCounter), compare(other.compare) {
+        copyFrom(other);
+    }
+
+    SmallHeapPriorityQueue& operator=(const SmallHeapPriorityQueue& other) {
+        if (this != &other) {
+            release();
+            heap = inlineHeap.data();
+            capacity = InlineCapacity;
+            size = 0;
+            insertCounter = other.insertCounter;
+            compare = other.compare;
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    //kopia kolejki zawsze ma wlasna tablice - nie ma czego odlaczac (zgodnosc z pozostalymi kolejkami)
+    void detach() {}
+
+    bool isShared() const {
+        return false;
+    }
+
+    void insert(const T& element, const Priority& priority) {
+        if (size == capacity) {
+            resize(capacity * 2);
+        }
+        heap[size] = HeapElement(priority, element, insertCounter.next());
+        heapifyUp(size);
+        size++;
+    }
+
+    T extractMax() {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+
+        T maxElement = std::move(heap[0].value);
+        if (isInline()) {
+            popRootBottomUp<false>(heap, size, precedesFn());
+        }
+        else {
+            popRootBottomUp(heap, size, precedesFn());
+        }
+        size--;
+
+        //zmniejszenie tablicy na stercie jak w HeapPriorityQueue (ostatecznie powrot do bufora)
+        if (!isInline() && size <= capacity / 4) {
+            resize(capacity / 2);
+        }
+        return maxElement;
+    }
+
+    T findMax() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return heap[0].value;
+    }
+
+    Priority findMaxPriority() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return heap[0].priority;
+    }
+
+    Priority getPriority(const T& element) const {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono elementu");
+        }
+        return heap[index].priority;
+    }
+
+    void modifyKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+
+        Priority oldPriority = heap[index].priority;
+        heap[index].priority = newPriority;
+        if (Order::higher(compare, newPriority, oldPriority)) {
+            heapifyUp(index);
+        }
+        else if (Order::higher(compare, oldPriority, newPriority)) {
+            heapifyDown(index);
+        }
+    }
+
+    void increaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+        if (!Order::higher(compare, newPriority, heap[index].priority)) {
+            throw std::runtime_error("Nowy priorytet musi byc wiekszy niz stary");
+        }
+        heap[index].priority = newPriority;
+        heapifyUp(index);
+    }
+
+    void decreaseKey(const T& element, const Priority& newPriority) {
+        std::size_t index = findElementIndex(element);
+        if (index == notFound) {
+            throw std::runtime_error("Nie znaleziono takiego elementu");
+        }
+        if (!Order::higher(compare, heap[index].priority, newPriority)) {
+            throw std::runtime_error("Nowy priorytet musi byc mniejszy niz stary");
+        }
+        heap[index].priority = newPriority;
+        heapifyDown(index);
+    }
+
+    std::size_t returnSize() const {
+        return size;
+    }
+
+    std::size_t returnCapacity() const {
+        return capacity;
+    }
+
+    //bufor wewnetrzny plus tablica na stercie, jesli kopiec sie do niej przeniosl
+    std::size_t memoryUsage() const {
+        return sizeof(inlineHeap) + (isInline() ? 0 : capacity * sizeof(HeapElement));
+    }
+
+    //czy elementy sa w tablicy na stercie (kolejka przekroczyla InlineCapacity)
+    bool isSpilled() const {
+        return !isInline();
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    //wyczyszczenie wraca do bufora wewnetrznego
+    void clear() {
+        release();
+        heap = inlineHeap.data();
+        capacity = InlineCapacity;
+        size = 0;
+    }
+
+    void print() const {
+        std::cout << "Kolejka Priorytetowa (Kopiec z buforem " << InlineCapacity << "): " << std::endl;
+        for (std::size_t i = 0; i < size; i++) {
+            std::cout << "Priorytet: " << heap[i].priority
+                << ", Element: " << heap[i].value;
+            heap[i].printInsertTime(std::cout);
+            std::cout << std::endl;
+        }
+    }
+};
+
+#endif // SMALL_HEAP_PRIORITY_QUEUE_H
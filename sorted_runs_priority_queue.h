@@ -0,0 +1,423 @@
+#ifndef SORTED_RUNS_PRIORITY_QUEUE_H
+#define SORTED_RUNS_PRIORITY_QUEUE_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <algorithm>
+#include "priority_order.h"
+
+//kolejka priorytetowa zoptymalizowana pod wstawianie (w stylu LSM) - wariant ArrayPriorityQueue
+//- insert dopisuje na koniec nieposortowanego bufora (O(1)), pamietajac najlepszy element bufora
+//- pelny bufor jest sortowany i staje sie przebiegiem; przebiegi o nie wiekszym rozmiarze sa z nim
+//  scalane (jak licznik binarny), wiec rozmiary rosna geometrycznie, a przebiegow jest O(log N),
+//  gdzie N to najwiekszy rozmiar kolejki (extractMax skraca przebiegi, ale ich nie usuwa, dopoki
+//  nie opustoszeja) - kazdy element jest scalany O(log N) razy, sekwencyjnie (bez skakania po
+//  tablicy jak w kopcu)
+//- przebieg jest posortowany od najgorszego do najlepszego, extractMax zdejmuje jego koniec;
+//  findMax/extractMax porownuja tylko konce przebiegow i najlepszy element bufora
+//- modifyKey to usuniecie elementu i ponowne wstawienie do bufora (z tym samym czasem wstawienia)
+//kopia kolejki jest pelna kopia (bez wspoldzielenia)
+template <typename T, typename Priority = int, typename Compare = std::less<Priority>, typename Stability = StableOrder>
+class SortedRunsPriorityQueue {
+private:
+    typedef PriorityOrder<Priority, Compare> Order;
+    typedef PriorityEntry<T, Priority, Stability> Entry;
+
+    //posortowany przebieg: data[0..size), najlepszy element na data[size - 1]
+    struct Run {
+        Entry* data;
+        std::size_t size;
+        std::size_t capacity;    //zaalokowana dlugosc data (size maleje przy extractMax)
+    };
+
+    Entry* buffer;               //nieposortowane ostatnie wstawienia
+    std::size_t bufferSize;
+    std::size_t bufferCapacity;
+    std::size_t bufferBest;      //indeks najlepszego elementu bufora (gdy bufferSize > 0)
+
+    Run* runs;                   //przebiegi od najstarszego (najwiekszego) do najmlodszego
+    std::size_t runCount;
+    std::size_t runCapacity;
+
+    std::size_t size;
+    InsertClock<Stability> insertCounter;
+    Compare compare;
+
+    static const std::size_t notFound = (std::size_t)-1;
+    static const std::size_t IN_BUFFER = (std::size_t)-2;    //miejsce elementu: bufor zamiast przebiegu
+
+    bool precedes(const Entry& a, const Entry& b) const {
+        if (Order::higher(compare, a.priority, b.priority)) {
+            return true;
+        }
+        if (Order::higher(compare, b.priority, a.priority)) {
+            return false;
+        }
+        return Entry::before(a, b);
+    }
+
+    //porzadek przebiegow: a przed b, gdy a jest gorszy (najlepszy element na koncu)
+    struct Ascending {
+        const SortedRunsPriorityQueue* queue;
+
+        bool operator()(const Entry& a, const Entry& b) const {
+            return queue->precedes(b, a);
+        }
+    };
+
+    Ascending ascendingFn() const {
+        Ascending fn = { this };
+        return fn;
+    }
+
+    void release() {
+        for (std::size_t r = 0; r < runCount; r++) {
+            delete[] runs[r].data;
+        }
+        delete[] runs;
+        delete[] buffer;
+    }
+
+    void copyFrom(const SortedRunsPriorityQueue& other) {
+        buffer = new Entry[bufferCapacity];
+        runs = new Run[runCapacity];
+        for (std::size_t i = 0; i < bufferSize; i++) {
+            buffer[i] = other.buffer[i];
+        }
+        for (std::size_t r = 0; r < runCount; r++) {
+            runs[r].size = other.runs[r].size;
+            runs[r].capacity = runs[r].size;
+            runs[r].data = new Entry[runs[r].size];
+            std::copy(other.runs[r].data, other.runs[r].data + runs[r].size, runs[r].data);
+        }
+    }
+
+    void updateBufferBest() {
+        bufferBest = 0;
+        for (std::size_t i = 1; i < bufferSize; i++) {
+            if (precedes(buffer[i], buffer[bufferBest])) {
+                bufferBest = i;
+            }
+        }
+    }
+
+    void pushRun(const Run& run) {
+        if (runCount == runCapacity) {
+            Run* newRuns = new Run[runCapacity * 2];
+            std::copy(runs, runs + runCount, newRuns);
+            delete[] runs;
+            runs = newRuns;
+            runCapacity *= 2;
+        }
+        runs[runCount++] = run;
+    }
+
+    //skrocenie przebiegu: pusty jest usuwany, a gdy zajmuje najwyzej cwierc tablicy, dostaje tablice
+    //dopasowana do rozmiaru (jak zmniejszanie pojemnosci w pozostalych kolejkach)
+    void shrinkRun(std::size_t r) {
+        Run& run = runs[r];
+        if (run.size == 0) {
+            removeRun(r);
+        }
+        else if (run.size <= run.capacity / 4) {
+            Entry* data = new Entry[run.size];
+            std::copy(run.data, run.data + run.size, data);
+            delete[] run.data;
+            run.data = data;
+            run.capacity = run.size;
+        }
+    }
+
+    void removeRun(std::size_t r) {
+        delete[] runs[r].data;
+        for (std::size_t i = r + 1; i < runCount; i++) {
+            runs[i - 1] = runs[i];
+        }
+        runCount--;
+    }
+
+    //posortowanie bufora w nowy przebieg i scalanie z przebiegami nie wiekszymi od niego
+    void flushBuffer() {
+        Run run;
+        run.size = bufferSize;
+        run.capacity = bufferSize;
+        run.data = new Entry[bufferSize];
+        std::copy(buffer, buffer + bufferSize, run.data);
+        std::sort(run.data, run.data + run.size, ascendingFn());
+        bufferSize = 0;
+
+        while (runCount > 0 && runs[runCount - 1].size <= run.size) {
+            Run& previous = runs[runCount - 1];
+            Run merged;
+            merged.size = previous.size + run.size;
+            merged.capacity = merged.size;
+            merged.data = new Entry[merged.size];
+            std::merge(previous.data, previous.data + previous.size, run.data, run.data + run.size,
+                merged.data, ascendingFn());
+            delete[] run.data;
+            delete[] previous.data;
+            runCount--;
+            run = merged;
+        }
+        pushRun(run);
+    }
+
+    //miejsce najlepszego elementu: indeks przebiegu albo IN_BUFFER
+    std::size_t bestSource() const {
+        std::size_t best = notFound;
+        const Entry* bestEntry = nullptr;
+        if (bufferSize > 0) {
+            best = IN_BUFFER;
+            bestEntry = &buffer[bufferBest];
+        }
+        for (std::size_t r = 0; r < runCount; r++) {
+            const Entry& head = runs[r].data[runs[r].size - 1];
+            if (bestEntry == nullptr || precedes(head, *bestEntry)) {
+                best = r;
+                bestEntry = &head;
+            }
+        }
+        return best;
+    }
+
+    const Entry& bestEntry() const {
+        std::size_t source = bestSource();
+        return source == IN_BUFFER ? buffer[bufferBest] : runs[source].data[runs[source].size - 1];
+    }
+
+    //wyszukanie elementu: source - przebieg albo IN_BUFFER, index - pozycja (notFound gdy brak)
+    void findElement(const T& element, std::size_t& source, std::size_t& index) const {
+        for (std::size_t i = 0; i < bufferSize; i++) {
+            if (buffer[i].value == element) {
+                source = IN_BUFFER;
+                index = i;
+                return;
+            }
+        }
+        for (std::size_t r = 0; r < runCount; r++) {
+            for (std::size_t i = 0; i < runs[r].size; i++) {
+                if (runs[r].data[i].value == element) {
+                    source = r;
+                    index = i;
+                    return;
+                }
+            }
+        }
+        source = notFound;
+        index = notFound;
+    }
+
+    const Entry& entryAt(std::size_t source, std::size_t index) const {
+        return source == IN_BUFFER ? buffer[index] : runs[source].data[index];
+    }
+
+    //wyjecie elementu z bufora lub przebiegu (w przebiegu przesuniecie reszty, porzadek zostaje)
+    Entry removeAt(std::size_t source, std::size_t index) {
+        Entry removed;
+        if (source == IN_BUFFER) {
+            removed = buffer[index];
+            buffer[index] = buffer[--bufferSize];
+            if (bufferSize > 0) {
+                updateBufferBest();
+            }
+        }
+        else {
+            Run& run = runs[source];
+            removed = run.data[index];
+            std::copy(run.data + index + 1, run.data + run.size, run.data + index);
+            run.size--;
+            shrinkRun(source);
+        }
+        size--;
+        return removed;
+    }
+
+    //wstawienie gotowego elementu do bufora (z zachowanym czasem wstawienia)
+    void append(const Entry& entry) {
+        if (bufferSize == bufferCapacity) {
+            flushBuffer();
+        }
+        buffer[bufferSize] = entry;
+        if (bufferSize == 0 || precedes(entry, buffer[bufferBest])) {
+            bufferBest = bufferSize;
+        }
+        bufferSize++;
+        size++;
+    }
+
+public:
+    //bufferCapacityValue - rozmiar bufora wstawien (i najmniejszego przebiegu)
+    SortedRunsPriorityQueue(std::size_t bufferCapacityValue = 64, const Compare& comparator = Compare()) :
+        bufferSize(0), bufferCapacity(bufferCapacityValue > 0 ? bufferCapacityValue : 1), bufferBest(0),
+        runCount(0), runCapacity(8), size(0), compare(comparator) {
+        buffer = new Entry[bufferCapacity];
+        runs = new Run[runCapacity];
+    }
+
+    ~SortedRunsPriorityQueue() {
+        release();
+    }
+
+    SortedRunsPriorityQueue(const SortedRunsPriorityQueue& other) :
+        bufferSize(other.bufferSize), bufferCapacity(other.bufferCapacity), bufferBest(other.bufferBest),
+        runCount(other.runCount), runCapacity(other.runCapacity), size(other.size),
+        insertCounter(other.insertCounter), compare(other.compare) {
+        copyFrom(other);
+    }
+
+    SortedRunsPriorityQueue& operator=(const SortedRunsPriorityQueue& other) {
+        if (this != &other) {
+            release();
+
+            bufferSize = other.bufferSize;
+            bufferCapacity = other.bufferCapacity;
+            bufferBest = other.bufferBest;
+            runCount = other.runCount;
+            runCapacity = other.runCapacity;
+            size = other.size;
+            insertCounter = other.insertCounter;
+            compare = other.compare;
+
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    //kopia kolejki zawsze ma wlasne tablice - nie ma czego odlaczac (zgodnosc z pozostalymi kolejkami)
+    void detach() {}
+
+    bool isShared() const {
+        return false;
+    }
+
+    //dodaj element na koniec bufora - O(1) zamortyzowane plus udzial w scalaniach
+    void insert(const T& element, const Priority& priority) {
+        append(Entry(priority, element, insertCounter.next()));
+    }
+
+    //usun element z najwiekszym priorytetem - porownanie koncow O(log N) przebiegow
+    T extractMax() {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+
+        std::size_t source = bestSource();
+        if (source == IN_BUFFER) {
+            return removeAt(IN_BUFFER, bufferBest).value;
+        }
+        Run& run = runs[source];
+        T maxElement = run.data[run.size - 1].value;
+        run.size--;
+        size--;
+        shrinkRun(source);
+        return maxElement;
+    }
+
+    T findMax() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return bestEntry().value;
+    }
+
+    Priority findMaxPriority() const {
+        if (size == 0) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return bestEntry().priority;
+    }
+
+    //priorytet elementu (przeszukanie bufora i przebiegow - O(n))
+    Priority getPriority(const T& element) const {
+        std::size_t source, index;
+        findElement(element, source, index);
+        if (index == notFound) {
+            throw std::runtime_error("Element nie znaleziony w kolejce");
+        }
+        return entryAt(source, index).priority;
+    }
+
+    //zmiana priorytetu: usuniecie i ponowne wstawienie do bufora
+    void modifyKey(const T& element, const Priority& newPriority) {
+        std::size_t source, index;
+        findElement(element, source, index);
+        if (index == notFound) {
+            throw std::runtime_error("Element nie znaleziony w kolejce");
+        }
+
+        Entry entry = removeAt(source, index);
+        entry.priority = newPriority;
+        append(entry);
+    }
+
+    void increaseKey(const T& element, const Priority& newPriority) {
+        if (!Order::higher(compare, newPriority, getPriority(element))) {
+            throw std::runtime_error("Nowy priorytet musi byc wiekszy niz obecny");
+        }
+        modifyKey(element, newPriority);
+    }
+
+    void decreaseKey(const T& element, const Priority& newPriority) {
+        if (!Order::higher(compare, getPriority(element), newPriority)) {
+            throw std::runtime_error("Nowy priorytet musi byc mniejszy niz obecny");
+        }
+        modifyKey(element, newPriority);
+    }
+
+    std::size_t returnSize() const {
+        return size;
+    }
+
+    //liczba zaalokowanych miejsc na elementy (bufor i przebiegi)
+    std::size_t returnCapacity() const {
+        std::size_t capacity = bufferCapacity;
+        for (std::size_t r = 0; r < runCount; r++) {
+            capacity += runs[r].capacity;
+        }
+        return capacity;
+    }
+
+    //liczba posortowanych przebiegow
+    std::size_t returnRunCount() const {
+        return runCount;
+    }
+
+    std::size_t memoryUsage() const {
+        return returnCapacity() * sizeof(Entry) + runCapacity * sizeof(Run);
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    void clear() {
+        for (std::size_t r = 0; r < runCount; r++) {
+            delete[] runs[r].data;
+        }
+        runCount = 0;
+        bufferSize = 0;
+        size = 0;
+    }
+
+    void print() const {
+        std::cout << "Kolejka Priorytetowa (Posortowane przebiegi): " << std::endl;
+        for (std::size_t r = 0; r < runCount; r++) {
+            std::cout << "Przebieg " << r << " (" << runs[r].size << " elementow):" << std::endl;
+            for (std::size_t i = runs[r].size; i-- > 0;) {
+                std::cout << "Priorytet: " << runs[r].data[i].priority << ", Element: " << runs[r].data[i].value;
+                runs[r].data[i].printInsertTime(std::cout);
+                std::cout << std::endl;
+            }
+        }
+        std::cout << "Bufor (" << bufferSize << " elementow):" << std::endl;
+        for (std::size_t i = 0; i < bufferSize; i++) {
+            std::cout << "Priorytet: " << buffer[i].priority << ", Element: " << buffer[i].value;
+            buffer[i].printInsertTime(std::cout);
+            std::cout << std::endl;
+        }
+    }
+};
+
+#endif // SORTED_RUNS_PRIORITY_QUEUE_H
@@ -0,0 +1,640 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <stdexcept>
+#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//hierarchiczne kolo czasowe (timing wheel) dla terminow wyrazonych w tickach
+//- LEVELS poziomow po SLOTS szczelin, poziom L obejmuje cyfre L terminu (po SLOT_BITS bitow)
+//- element trafia na poziom najwyzszej cyfry, w ktorej jego termin rozni sie od biezacego czasu,
+//  terminy poza zasiegiem wszystkich poziomow czekaja na liscie przepelnienia
+//- przesuwanie czasu przenosi (kaskaduje) szczeliny wyzszych poziomow na nizsze, puste
+//  zakresy sa przeskakiwane dzieki mapom zajetosci szczelin
+//- schedule i cancel dzialaja w O(1): wezly sa w puli z lista wolnych i w listach dwukierunkowych
+//- uchwyt (handle) zawiera indeks wezla i generacje, wiec anulowanie nieaktualnego uchwytu
+//  (element juz wygasl lub zostal anulowany) jest bezpieczne i zwraca false
+template <typename T>
+class TimingWheel {
+public:
+    typedef unsigned long long Tick;
+
+    struct Handle {
+        std::size_t node;
+        unsigned long long generation;
+    };
+
+    static const unsigned SLOT_BITS = 8;
+    static const unsigned LEVELS = 6;
+    static const std::size_t SLOTS = (std::size_t)1 << SLOT_BITS;
+
+private:
+    static const std::size_t NONE = (std::size_t)-1;
+    static const std::size_t BITMAP_WORDS = SLOTS / 64;
+    static const std::size_t OVERFLOW_LIST = LEVELS * SLOTS;     //terminy poza zasiegiem kola
+    static const std::size_t EXPIRED_LIST = LEVELS * SLOTS + 1;  //wygasle, czekaja na odebranie
+    static const std::size_t LIST_COUNT = LEVELS * SLOTS + 2;
+
+    struct Node {
+        T value;
+        Tick deadline;
+        std::size_t prev;
+        std::size_t next;
+        std::size_t list;               //NONE gdy wezel jest wolny
+        unsigned long long generation;
+    };
+
+    Node* nodes;
+    std::size_t capacity;
+    std::size_t freeHead;
+
+    std::size_t heads[LIST_COUNT];
+    std::size_t tails[LIST_COUNT];
+    unsigned long long occupied[LEVELS][BITMAP_WORDS];
+
+    Tick now;
+    std::size_t size;
+
+    static unsigned lowestBit(unsigned long long word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return (unsigned)__builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return (unsigned)index;
+#else
+        unsigned index = 0;
+        while ((word & 1ULL) == 0) {
+            word >>= 1;
+            index++;
+        }
+        return index;
+#endif
+    }
+
+    static std::size_t listOf(unsigned level, std::size_t slot) {
+        return level * SLOTS + slot;
+    }
+
+    static std::size_t digitOf(Tick tick, unsigned level) {
+        return (std::size_t)((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+    }
+
+    void resize() {
+        std::size_t newCapacity = capacity * 2;
+        Node* newNodes = new Node[newCapacity];
+        for (std::size_t i = 0; i < capacity; i++) {
+            newNodes[i] = std::move(nodes[i]);
+        }
+        for (std::size_t i = capacity; i < newCapacity; i++) {
+            newNodes[i].list = NONE;
+            newNodes[i].generation = 0;
+            newNodes[i].next = (i + 1 < newCapacity) ? i + 1 : freeHead;
+        }
+        freeHead = capacity;
+        delete[] nodes;
+        nodes = newNodes;
+        capacity = newCapacity;
+    }
+
+    void initialize(std::size_t initialCapacity) {
+        capacity = initialCapacity > 0 ? initialCapacity : 1;
+        nodes = new Node[capacity];
+        for (std::size_t i = 0; i < capacity; i++) {
+            nodes[i].list = NONE;
+            nodes[i].generation = 0;
+            nodes[i].next = (i + 1 < capacity) ? i + 1 : NONE;
+        }
+        freeHead = 0;
+        for (std::size_t i = 0; i < LIST_COUNT; i++) {
+            heads[i] = NONE;
+            tails[i] = NONE;
+        }
+        for (unsigned level = 0; level < LEVELS; level++) {
+            for (std::size_t w = 0; w < BITMAP_WORDS; w++) {
+                occupied[level][w] = 0;
+            }
+        }
+        size = 0;
+    }
+
+    void copyFrom(const TimingWheel& other) {
+        capacity = other.capacity;
+        nodes = new Node[capacity];
+        for (std::size_t i = 0; i < capacity; i++) {
+            nodes[i] = other.nodes[i];
+        }
+        freeHead = other.freeHead;
+        for (std::size_t i = 0; i < LIST_COUNT; i++) {
+            heads[i] = other.heads[i];
+            tails[i] = other.tails[i];
+        }
+        for (unsigned level = 0; level < LEVELS; level++) {
+            for (std::size_t w = 0; w < BITMAP_WORDS; w++) {
+                occupied[level][w] = other.occupied[level][w];
+            }
+        }
+        now = other.now;
+        size = other.size;
+    }
+
+    //dolacz wezel na koniec listy (kolejnosc FIFO w obrebie szczeliny)
+    void link(std::size_t index, std::size_t list) {
+        Node& node = nodes[index];
+        node.list = list;
+        node.next = NONE;
+        node.prev = tails[list];
+        if (tails[list] == NONE) {
+            heads[list] = index;
+            if (list < OVERFLOW_LIST) {
+                occupied[list / SLOTS][(list % SLOTS) / 64] |= 1ULL << (list % 64);
+            }
+        }
+        else {
+            nodes[tails[list]].next = index;
+        }
+        tails[list] = index;
+    }
+
+    //wstawienie na liste wygaslych w kolejnosci terminow (FIFO przy rownych terminach)
+    //kaskada i terminy nie wczesniejsze od ostatniego wygaslego to O(1) - dolaczenie na koniec;
+    //termin z przeszlosci wczesniejszy od czekajacych przechodzi po pozniejszych od konca listy
+    void linkExpired(std::size_t index) {
+        std::size_t after = tails[EXPIRED_LIST];
+        while (after != NONE && nodes[after].deadline > nodes[index].deadline) {
+            after = nodes[after].prev;
+        }
+        if (after == tails[EXPIRED_LIST]) {
+            link(index, EXPIRED_LIST);
+            return;
+        }
+
+        Node& node = nodes[index];
+        node.list = EXPIRED_LIST;
+        node.prev = after;
+        node.next = after == NONE ? heads[EXPIRED_LIST] : nodes[after].next;
+        nodes[node.next].prev = index;
+        if (after == NONE) {
+            heads[EXPIRED_LIST] = index;
+        }
+        else {
+            nodes[after].next = index;
+        }
+    }
+
+    void unlink(std::size_t index) {
+        Node& node = nodes[index];
+        std::size_t list = node.list;
+        if (node.prev != NONE) {
+            nodes[node.prev].next = node.next;
+        }
+        else {
+            heads[list] = node.next;
+        }
+        if (node.next != NONE) {
+            nodes[node.next].prev = node.prev;
+        }
+        else {
+            tails[list] = node.prev;
+        }
+        if (heads[list] == NONE && list < OVERFLOW_LIST) {
+            occupied[list / SLOTS][(list % SLOTS) / 64] &= ~(1ULL << (list % 64));
+        }
+        node.list = NONE;
+    }
+
+    void release(std::size_t index) {
+        nodes[index].generation++;
+        nodes[index].list = NONE;
+        nodes[index].next = freeHead;
+        freeHead = index;
+    }
+
+    //wybor listy dla terminu wzgledem biezacego czasu
+    void place(std::size_t index) {
+        Tick deadline = nodes[index].deadline;
+        if (deadline <= now) {
+            linkExpired(index);
+            return;
+        }
+
+        Tick difference = deadline ^ now;
+        unsigned level = 0;
+        while (level + 1 < LEVELS && (difference >> ((level + 1) * SLOT_BITS)) != 0) {
+            level++;
+        }
+        if ((difference >> (level * SLOT_BITS)) >= SLOTS) {
+            link(index, OVERFLOW_LIST);
+            return;
+        }
+        link(index, listOf(level, digitOf(deadline, level)));
+    }
+
+    //przeniesienie calej listy wedlug biezacego czasu (elementy trafiaja nizej lub wygasaja)
+    //lista jest najpierw odpinana w calosci - element z przepelnienia moze na nia wrocic
+    void cascade(std::size_t list) {
+        std::size_t index = heads[list];
+        heads[list] = NONE;
+        tails[list] = NONE;
+        if (list < OVERFLOW_LIST) {
+            occupied[list / SLOTS][(list % SLOTS) / 64] &= ~(1ULL << (list % 64));
+        }
+        while (index != NONE) {
+            std::size_t next = nodes[index].next;
+            place(index);
+            index = next;
+        }
+    }
+
+    //pierwsza zajeta szczelina poziomu o indeksie >= from, NONE gdy brak
+    std::size_t nextOccupied(unsigned level, std::size_t from) const {
+        if (from >= SLOTS) {
+            return NONE;
+        }
+        std::size_t word = from / 64;
+        unsigned long long bits = occupied[level][word] & (~0ULL << (from % 64));
+        while (true) {
+            if (bits != 0) {
+                return word * 64 + lowestBit(bits);
+            }
+            word++;
+            if (word >= BITMAP_WORDS) {
+                return NONE;
+            }
+            bits = occupied[level][word];
+        }
+    }
+
+    //najblizszy tick > now, w ktorym cos sie dzieje (wygasniecie lub kaskada), oraz jego lista
+    //zwraca false gdy kolo jest puste (poza lista wygaslych)
+    bool nextEvent(Tick& tick, std::size_t& list) const {
+        for (unsigned level = 0; level < LEVELS; level++) {
+            std::size_t slot = nextOccupied(level, digitOf(now, level) + 1);
+            if (slot != NONE) {
+                unsigned shift = level * SLOT_BITS;
+                Tick rotation = (now >> shift >> SLOT_BITS) << SLOT_BITS;
+                tick = (rotation | slot) << shift;
+                list = listOf(level, slot);
+                return true;
+            }
+        }
+        if (heads[OVERFLOW_LIST] != NONE) {
+            unsigned shift = LEVELS * SLOT_BITS;
+            tick = ((now >> shift) + 1) << shift;
+            list = OVERFLOW_LIST;
+            return true;
+        }
+        return false;
+    }
+
+    //jeden krok czasu: do najblizszego zdarzenia <= target (kaskada szczeliny)
+    //false gdy do target nie ma juz zdarzen - wtedy czas ustawiany jest na target
+    bool step(Tick target) {
+        if (target <= now) {
+            return false;
+        }
+        Tick tick;
+        std::size_t list;
+        if (!nextEvent(tick, list) || tick > target) {
+            now = target;
+            return false;
+        }
+        now = tick;
+        cascade(list);
+        return true;
+    }
+
+    //wezel z najwczesniejszym terminem (przy rownych terminach - pierwszy wstawiony)
+    std::size_t earliestNode() const {
+        if (heads[EXPIRED_LIST] != NONE) {
+            return heads[EXPIRED_LIST];
+        }
+
+        Tick tick;
+        std::size_t list;
+        if (!nextEvent(tick, list)) {
+            return NONE;
+        }
+        std::size_t best = heads[list];
+        if (list >= SLOTS) {
+            //szczelina wyzszego poziomu obejmuje zakres terminow - szukamy minimum na liscie
+            for (std::size_t index = nodes[best].next; index != NONE; index = nodes[index].next) {
+                if (nodes[index].deadline < nodes[best].deadline) {
+                    best = index;
+                }
+            }
+        }
+        return best;
+    }
+
+public:
+    TimingWheel(std::size_t initialCapacity = 64, Tick startTime = 0) : now(startTime) {
+        initialize(initialCapacity);
+    }
+
+    TimingWheel(const TimingWheel& other) {
+        copyFrom(other);
+    }
+
+    TimingWheel& operator=(const TimingWheel& other) {
+        if (this != &other) {
+            delete[] nodes;
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    ~TimingWheel() {
+        delete[] nodes;
+    }
+
+    //zaplanowanie elementu na dany termin - O(1)
+    //termin <= biezacy czas trafia od razu do wygaslych (na miejsce wedlug terminu - patrz linkExpired)
+    Handle schedule(const T& value, Tick deadline) {
+        if (freeHead == NONE) {
+            resize();
+        }
+        std::size_t index = freeHead;
+        freeHead = nodes[index].next;
+
+        nodes[index].value = value;
+        nodes[index].deadline = deadline;
+        place(index);
+        size++;
+
+        Handle handle;
+        handle.node = index;
+        handle.generation = nodes[index].generation;
+        return handle;
+    }
+
+    //anulowanie - O(1), false gdy uchwyt jest nieaktualny
+    bool cancel(const Handle& handle) {
+        if (!isPending(handle)) {
+            return false;
+        }
+        unlink(handle.node);
+        release(handle.node);
+        size--;
+        return true;
+    }
+
+    bool isPending(const Handle& handle) const {
+        return handle.node < capacity && nodes[handle.node].list != NONE &&
+            nodes[handle.node].generation == handle.generation;
+    }
+
+    const T& valueOf(const Handle& handle) const {
+        if (!isPending(handle)) {
+            throw std::runtime_error("Nieaktualny uchwyt zegara");
+        }
+        return nodes[handle.node].value;
+    }
+
+    Tick deadlineOf(const Handle& handle) const {
+        if (!isPending(handle)) {
+            throw std::runtime_error("Nieaktualny uchwyt zegara");
+        }
+        return nodes[handle.node].deadline;
+    }
+
+    //przesuniecie czasu do target i odebranie co najwyzej maxBatch wygaslych elementow
+    //(w kolejnosci terminow, FIFO przy rownych terminach); zwraca liczbe zapisanych do expired
+    //gdy paczka sie zapelni, czas zatrzymuje sie wczesniej - kolejne wywolanie odbiera reszte,
+    //0 oznacza, ze do target nic wiecej nie wygasa
+    std::size_t advanceTo(Tick target, T* expired, std::size_t maxBatch) {
+        std::size_t count = 0;
+        while (true) {
+            while (count < maxBatch && heads[EXPIRED_LIST] != NONE) {
+                std::size_t index = heads[EXPIRED_LIST];
+                unlink(index);
+                expired[count++] = std::move(nodes[index].value);
+                release(index);
+                size--;
+            }
+            if (count == maxBatch || !step(target)) {
+                return count;
+            }
+        }
+    }
+
+    //przesuniecie czasu bez odbierania - wygasle elementy czekaja na advanceTo
+    void advanceTime(Tick target) {
+        while (step(target)) {
+        }
+    }
+
+    //najwczesniejszy termin bez przesuwania czasu, false gdy kolo jest puste
+    bool nextDeadline(Tick& deadline) const {
+        std::size_t index = earliestNode();
+        if (index == NONE) {
+            return false;
+        }
+        deadline = nodes[index].deadline;
+        return true;
+    }
+
+    //uchwyt elementu z najwczesniejszym terminem
+    Handle earliest() const {
+        std::size_t index = earliestNode();
+        if (index == NONE) {
+            throw std::runtime_error("Kolo czasowe jest puste");
+        }
+        Handle handle;
+        handle.node = index;
+        handle.generation = nodes[index].generation;
+        return handle;
+    }
+
+    Tick currentTime() const {
+        return now;
+    }
+
+    std::size_t returnSize() const {
+        return size;
+    }
+
+    std::size_t returnCapacity() const {
+        return capacity;
+    }
+
+    std::size_t memoryUsage() const {
+        return sizeof(*this) + capacity * sizeof(Node);
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    void clear() {
+        delete[] nodes;
+        initialize(capacity);
+    }
+
+    void print() const {
+        std::cout << "Kolo czasowe (czas " << now << ", elementow " << size << "):" << std::endl;
+        for (std::size_t list = 0; list < LIST_COUNT; list++) {
+            for (std::size_t index = heads[list]; index != NONE; index = nodes[index].next) {
+                std::cout << "(" << nodes[index].value << ", termin: " << nodes[index].deadline;
+                if (list == EXPIRED_LIST) {
+                    std::cout << ", wygasl";
+                }
+                else if (list == OVERFLOW_LIST) {
+                    std::cout << ", poza kolem";
+                }
+                else {
+                    std::cout << ", poziom: " << list / SLOTS << ", szczelina: " << list % SLOTS;
+                }
+                std::cout << ") " << std::endl;
+            }
+        }
+    }
+};
+
+//kolejka priorytetowa terminow na kole czasowym - wspolny interfejs kolejek
+//najwyzszy priorytet ma najwczesniejszy termin; increaseKey oznacza wczesniejszy termin
+//extractMax przesuwa czas kola do wyjetego terminu, wiec kolejka jest monotoniczna:
+//termin wczesniejszy niz ostatnio wyjety trafia od razu do wygaslych (obslugiwanych w kolejnosci
+//terminow, wiec extractMax nadal zwraca najwczesniejszy termin)
+//elementy musza byc unikalne i hashowalne - mapa element -> uchwyt daje modifyKey i remove w O(1)
+template <typename T, typename Hash = std::hash<T> >
+class TimingWheelPriorityQueue {
+public:
+    typedef typename TimingWheel<T>::Tick Tick;
+
+private:
+    typedef typename TimingWheel<T>::Handle Handle;
+
+    TimingWheel<T> wheel;
+    std::unordered_map<T, Handle, Hash> handles;
+
+    Handle handleOf(const T& element) const {
+        typename std::unordered_map<T, Handle, Hash>::const_iterator it = handles.find(element);
+        if (it == handles.end()) {
+            throw std::runtime_error("Element nie zostal znaleziony w kolejce");
+        }
+        return it->second;
+    }
+
+public:
+    TimingWheelPriorityQueue(std::size_t initialCapacity = 10) : wheel(initialCapacity) {
+        handles.reserve(initialCapacity);
+    }
+
+    void insert(const T& element, Tick deadline) {
+        if (handles.find(element) != handles.end()) {
+            throw std::runtime_error("Element juz jest w kolejce");
+        }
+        handles[element] = wheel.schedule(element, deadline);
+    }
+
+    T extractMax() {
+        if (wheel.isEmpty()) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        Handle top = wheel.earliest();
+        Tick deadline = wheel.deadlineOf(top);
+        if (deadline > wheel.currentTime()) {
+            //przesuniecie czasu kaskaduje wyzsze poziomy, wiec kolejne wyjecia sa tanie
+            wheel.advanceTime(deadline);
+        }
+        T element = wheel.valueOf(top);
+        wheel.cancel(top);
+        handles.erase(element);
+        return element;
+    }
+
+    T findMax() const {
+        if (wheel.isEmpty()) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return wheel.valueOf(wheel.earliest());
+    }
+
+    Tick findMaxPriority() const {
+        if (wheel.isEmpty()) {
+            throw std::runtime_error("Kolejka jest pusta");
+        }
+        return wheel.deadlineOf(wheel.earliest());
+    }
+
+    Tick getPriority(const T& element) const {
+        return wheel.deadlineOf(handleOf(element));
+    }
+
+    //zmiana terminu: anulowanie i ponowne zaplanowanie - O(1)
+    void modifyKey(const T& element, Tick newDeadline) {
+        Handle handle = handleOf(element);
+        wheel.cancel(handle);
+        handles[element] = wheel.schedule(element, newDeadline);
+    }
+
+    //zwiekszenie priorytetu = przesuniecie terminu na wczesniejszy
+    void increaseKey(const T& element, Tick newDeadline) {
+        if (newDeadline > getPriority(element)) {
+            throw std::runtime_error("Nowy termin musi byc wczesniejszy od obecnego");
+        }
+        modifyKey(element, newDeadline);
+    }
+
+    //zmniejszenie priorytetu = przesuniecie terminu na pozniejszy
+    void decreaseKey(const T& element, Tick newDeadline) {
+        if (newDeadline < getPriority(element)) {
+            throw std::runtime_error("Nowy termin musi byc pozniejszy od obecnego");
+        }
+        modifyKey(element, newDeadline);
+    }
+
+    //anulowanie elementu - O(1)
+    void remove(const T& element) {
+        wheel.cancel(handleOf(element));
+        handles.erase(element);
+    }
+
+    //przesuniecie czasu i odebranie paczki wygaslych elementow (patrz TimingWheel::advanceTo)
+    std::size_t advanceTo(Tick now, T* expired, std::size_t maxBatch) {
+        std::size_t count = wheel.advanceTo(now, expired, maxBatch);
+        for (std::size_t i = 0; i < count; i++) {
+            handles.erase(expired[i]);
+        }
+        return count;
+    }
+
+    Tick currentTime() const {
+        return wheel.currentTime();
+    }
+
+    std::size_t returnSize() const {
+        return wheel.returnSize();
+    }
+
+    std::size_t returnCapacity() const {
+        return wheel.returnCapacity();
+    }
+
+    std::size_t memoryUsage() const {
+        return wheel.memoryUsage() + handles.bucket_count() * sizeof(void*) +
+            handles.size() * (sizeof(T) + sizeof(Handle) + 2 * sizeof(void*));
+    }
+
+    bool isEmpty() const {
+        return wheel.isEmpty();
+    }
+
+    void clear() {
+        wheel.clear();
+        handles.clear();
+    }
+
+    void print() const {
+        wheel.print();
+    }
+};
+
+#endif // TIMING_WHEEL_H